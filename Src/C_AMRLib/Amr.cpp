@@ -86,10 +86,15 @@ namespace
     int  checkpoint_nfiles;
     int  regrid_on_restart;
     int  use_efficient_regrid;
+    Real regrid_tolerance;
     int  plotfile_on_restart;
     int  checkpoint_on_restart;
     bool checkpoint_files_output;
     int  compute_new_dt_on_regrid;
+    int  async_advance;
+    int  calibrate_work;
+    Real work_smoothing;
+    bool fillpatch_plans;
     bool precreateDirectories;
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
@@ -113,10 +118,15 @@ Amr::Initialize ()
     checkpoint_nfiles        = 64;
     regrid_on_restart        = 0;
     use_efficient_regrid     = 0;
+    regrid_tolerance         = -1;
     plotfile_on_restart      = 0;
     checkpoint_on_restart    = 0;
     checkpoint_files_output  = true;
     compute_new_dt_on_regrid = 0;
+    async_advance            = 0;
+    calibrate_work           = 0;
+    work_smoothing           = 0.5;
+    fillpatch_plans          = false;
     precreateDirectories     = true;
     prereadFAHeaders         = true;
     plot_headerversion       = VisMF::Header::Version_v1;
@@ -140,6 +150,8 @@ Amr::Finalize ()
 
 bool Amr::Plot_Files_Output () { return plot_files_output; }
 
+bool Amr::FillPatch_Plans () { return fillpatch_plans; }
+
 std::ostream&
 Amr::DataLog (int i)
 {
@@ -248,10 +260,16 @@ Amr::InitAmr ()
     //
     pp.query("regrid_on_restart",regrid_on_restart);
     pp.query("use_efficient_regrid",use_efficient_regrid);
+    pp.query("regrid_tolerance",regrid_tolerance);
     pp.query("plotfile_on_restart",plotfile_on_restart);
     pp.query("checkpoint_on_restart",checkpoint_on_restart);
 
     pp.query("compute_new_dt_on_regrid",compute_new_dt_on_regrid);
+    pp.query("async_advance",async_advance);
+    pp.query("calibrate_work",calibrate_work);
+    pp.query("work_smoothing",work_smoothing);
+    work_smoothing = std::max(Real(0), std::min(Real(1), work_smoothing));
+    pp.query("fillpatch_plans",fillpatch_plans);
 
     pp.query("mffile_nstreams", mffile_nstreams);
     pp.query("probinit_natonce", probinit_natonce);
@@ -315,6 +333,11 @@ Amr::InitAmr ()
     level_count.resize(nlev);
     n_cycle.resize(nlev);
     dt_min.resize(nlev);
+    work_per_cell.resize(nlev,-1);
+    ghost_per_halo.resize(nlev,0);
+    fp_seconds.resize(nlev,0);
+    fp_ghosts.resize(nlev,0);
+    work_per_ghost = -1;
     amr_level.resize(nlev);
     //
     // Set bogus values.
@@ -1272,6 +1295,10 @@ Amr::FinalizeInit (Real              strt_time,
     station.init(amr_level, finestLevel());
     station.findGrid(amr_level,Geom());
 #endif
+
+#ifdef USE_INSITU
+    insitu.init(*this);
+#endif
     BL_COMM_PROFILE_NAMETAG("Amr::initialInit BOTTOM");
 }
 
@@ -1572,6 +1599,10 @@ Amr::restart (const std::string& filename)
     station.findGrid(amr_level,Geom());
 #endif
 
+#ifdef USE_INSITU
+    insitu.init(*this);
+#endif
+
     if (verbose > 0)
     {
         Real dRestartTime = ParallelDescriptor::second() - dRestartTime0;
@@ -1872,10 +1903,37 @@ Amr::timeStep (int  level,
                   << dt_level[level]
                   << std::endl;
     }
+    if (async_advance)
+    {
+        //
+        // Start the same-level exchanges of the next finer level's first
+        // subcycle so they overlap this level's advance.
+        //
+        if (level < finest_level)
+        {
+            amr_level[level+1].prefetchAdvance(time,dt_level[level+1],1,
+                                               sub_cycle ? n_cycle[level+1] : 1);
+        }
+        amr_level[level].recordFillPatches(true,time);
+    }
+
+    const Real strt_advance = calibrate_work ? ParallelDescriptor::second() : 0;
+
+    fp_seconds[level] = fp_ghosts[level] = 0;
+
     BL_PROFILE_REGION_START("amr_level.advance");
     Real dt_new = amr_level[level].advance(time,dt_level[level],iteration,niter);
     BL_PROFILE_REGION_STOP("amr_level.advance");
 
+    if (calibrate_work)
+        calibrateWork(level, ParallelDescriptor::second() - strt_advance);
+
+    if (async_advance)
+    {
+        amr_level[level].recordFillPatches(false);
+        amr_level[level].clearPrefetch();
+    }
+
     dt_min[level] = iteration == 1 ? dt_new : std::min(dt_min[level],dt_new);
 
     level_steps[level]++;
@@ -1977,6 +2035,10 @@ Amr::coarseTimeStep (Real stop_time)
 
     amr_level[0].postCoarseTimeStep(cumtime);
 
+#ifdef USE_INSITU
+    insitu.report(*this,level_steps[0],cumtime);
+#endif
+
 #ifdef BL_PROFILING
 #ifdef DEBUG
     std::stringstream dfss;
@@ -2277,6 +2339,38 @@ Amr::defBaseLevel (Real              strt_time,
     amr_level[0].initData();
 }
 
+//
+// True if the new grids differ from the old ones by at most the fraction
+// tol: no more than tol of the new cells lie outside the old grids, and
+// no more than tol of the old cells lie outside the new grids.
+//
+static
+bool
+GridsWithinTolerance (const BoxArray& ba_old,
+                      const BoxArray& ba_new,
+                      Real            tol)
+{
+    if (ba_old == ba_new) return true;
+
+    const long npts_old = ba_old.numPts();
+    const long npts_new = ba_new.numPts();
+
+    long overlap = 0;
+
+    std::vector< std::pair<int,Box> > isects;
+
+    for (int i = 0, N = ba_new.size(); i < N; i++)
+    {
+        ba_old.intersections(ba_new[i],isects);
+
+        for (int k = 0, NI = isects.size(); k < NI; k++)
+            overlap += isects[k].second.numPts();
+    }
+
+    return (npts_new - overlap) <= tol*npts_new
+        && (npts_old - overlap) <= tol*npts_old;
+}
+
 void
 Amr::regrid (int  lbase,
              Real time,
@@ -2287,6 +2381,9 @@ Amr::regrid (int  lbase,
     if (verbose > 0 && ParallelDescriptor::IOProcessor())
         std::cout << "Now regridding at level lbase = " << lbase << std::endl;
 
+    for (int lev = 0; lev <= finest_level; lev++)
+        amr_level[lev].clearPrefetch();
+
     //
     // Compute positions of new grids.
     //
@@ -2322,6 +2419,48 @@ Amr::regrid (int  lbase,
 	}
 	return;
     }
+    //
+    // With amr.regrid_tolerance >= 0, grids that changed by no more than
+    // that fraction at every level are kept as they are.
+    //
+    if (regrid_tolerance >= 0 && !initial && finest_level == new_finest)
+    {
+        bool within_tolerance = true;
+
+        for (int lev = start; within_tolerance && lev <= finest_level; lev++)
+        {
+            within_tolerance = GridsWithinTolerance(amr_level[lev].boxArray(),
+                                                    new_grid_places[lev],
+                                                    regrid_tolerance);
+        }
+
+        if (within_tolerance)
+        {
+            if (verbose > 0 && ParallelDescriptor::IOProcessor()) {
+                std::cout << "Regridding at level lbase = " << lbase 
+                          << " but grids changed by less than amr.regrid_tolerance = "
+                          << regrid_tolerance << std::endl;
+            }
+            return;
+        }
+    }
+    //
+    // Otherwise the levels from start up whose grids did not change at
+    // all keep their AmrLevel, and so their data, instead of being rebuilt
+    // and filled from themselves.  The first level that changes and all
+    // finer ones are rebuilt, so proper nesting is kept.
+    //
+    int keep_upto = start-1;
+
+    if (regrid_tolerance >= 0 && !initial)
+    {
+        for (int lev = start, End = std::min(finest_level,new_finest); lev <= End; lev++)
+        {
+            if (new_grid_places[lev] != amr_level[lev].boxArray()) break;
+
+            keep_upto = lev;
+        }
+    }
 
     //
     // Reclaim old-time grid space for all remain levels > lbase.
@@ -2350,7 +2489,7 @@ Amr::regrid (int  lbase,
     //
     // Define the new grids from level start up to new_finest.
     //
-    for(int lev = start; lev <= new_finest; ++lev) {
+    for(int lev = keep_upto+1; lev <= new_finest; ++lev) {
         //
         // Construct skeleton of new level.
         //
@@ -2390,7 +2529,16 @@ Amr::regrid (int  lbase,
 	this->SetDistributionMap(lev, DistributionMapping(amr_level[lev].boxArray(),
 							  ParallelDescriptor::NProcs()));
     }
-
+    //
+    // Don't hold onto what the old levels gave back to the StateData pool
+    // on grids that are gone.
+    //
+    {
+        Array<BoxArray> grids(finest_level+1);
+        for (int lev = 0; lev <= finest_level; ++lev)
+            grids[lev] = amr_level[lev].boxArray();
+        StateData::TrimPool(grids);
+    }
 
     //
     // Check at *all* levels whether we need to do anything special now that the grids
@@ -2409,11 +2557,13 @@ Amr::regrid (int  lbase,
 	}
         Array<Array<int> > mLDM;
 	if(rebalance_grids == 1) {
-          mLDM = DistributionMapping::MultiLevelMapPFC(ref_ratio, allBoxes, maxGridSize(0));
+          mLDM = DistributionMapping::MultiLevelMapPFC(ref_ratio, allBoxes, maxGridSize(0),
+                                                       estimateBoxWork(allBoxes));
 	} else if(rebalance_grids == 2) {
           mLDM = DistributionMapping::MultiLevelMapRandom(ref_ratio, allBoxes, maxGridSize(0));
 	} else if(rebalance_grids == 3) {
-          mLDM = DistributionMapping::MultiLevelMapKnapSack(ref_ratio, allBoxes, maxGridSize(0));
+          mLDM = DistributionMapping::MultiLevelMapKnapSack(ref_ratio, allBoxes, maxGridSize(0),
+                                                            estimateBoxWork(allBoxes));
 	} else if(rebalance_grids == 4) {  // ---- move all grids to proc zero
           mLDM = DistributionMapping::MultiLevelMapRandom(ref_ratio, allBoxes, maxGridSize(0), 0);
 	} else {
@@ -2942,7 +3092,8 @@ Amr::initSubcycle ()
     }
     else if (subcycling_mode == "Optimal")
     {
-        // if subcycling mode is Optimal, n_cycle is set dynamically.
+        // if subcycling mode is Optimal, n_cycle is set dynamically by
+        // AmrLevel::computeNewDt() through computeOptimalSubcycling().
         // We'll initialize it to be Auto subcycling.
         n_cycle[0] = 1;
         for (int i = 1; i <= max_level; i++)
@@ -3099,6 +3250,131 @@ Amr::computeOptimalSubcycling(int n, int* best, Real* dt_max, Real* est_work, in
     return best_dt;
 }
 
+Real
+Amr::computeOptimalSubcycling (int   n,
+                               int*  best,
+                               Real* dt_max,
+                               int*  cycle_max)
+{
+    Array<Real> est_work(n);
+
+    for (int i = 0; i < n; i++)
+        est_work[i] = amr_level[i].estimateWork();
+
+    return computeOptimalSubcycling(n,best,dt_max,est_work.dataPtr(),cycle_max);
+}
+
+bool
+Amr::calibratingWork () const
+{
+    return calibrate_work;
+}
+
+void
+Amr::recordFillPatchWork (int  lev,
+                          Real seconds,
+                          Real nghost)
+{
+    fp_seconds[lev] += seconds;
+    fp_ghosts[lev]  += nghost;
+}
+
+void
+Amr::calibrateWork (int  lev,
+                    Real seconds)
+{
+    //
+    // Total CPU seconds of the advance and its FillPatches over all CPUs.
+    //
+    Real r[3] = { seconds, fp_seconds[lev], fp_ghosts[lev] };
+
+    ParallelDescriptor::ReduceRealSum(r,3);
+
+    const BoxArray& ba = boxArray(lev);
+
+    Real ncells = 0, nhalo = 0;
+
+    for (int i = 0, N = ba.size(); i < N; i++)
+    {
+        ncells += ba[i].d_numPts();
+        nhalo  += BoxLib::grow(ba[i],1).d_numPts() - ba[i].d_numPts();
+    }
+
+    const Real per_cell = std::max(Real(0), r[0] - r[1]) / ncells;
+
+    work_per_cell[lev] = (work_per_cell[lev] < 0) ? per_cell :
+        (1-work_smoothing)*work_per_cell[lev] + work_smoothing*per_cell;
+
+    if (r[2] > 0)
+    {
+        const Real per_ghost = r[1] / r[2];
+
+        work_per_ghost = (work_per_ghost < 0) ? per_ghost :
+            (1-work_smoothing)*work_per_ghost + work_smoothing*per_ghost;
+
+        ghost_per_halo[lev] = r[2] / nhalo;
+    }
+
+    if (verbose > 1 && ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "[Level " << lev << "] work per cell: " << work_per_cell[lev]
+                  << ", per ghost cell: " << work_per_ghost << std::endl;
+    }
+}
+
+Real
+Amr::estimateWork (int        lev,
+                   const Box& bx) const
+{
+    //
+    // The nearest level at or coarser than lev that has been calibrated.
+    //
+    int l = lev;
+
+    while (l >= 0 && work_per_cell[l] < 0)
+        l--;
+
+    if (!calibrate_work || l < 0)
+        return bx.d_numPts();
+
+    Real work = work_per_cell[l] * bx.d_numPts();
+
+    if (work_per_ghost > 0)
+        work += work_per_ghost * ghost_per_halo[l] * (BoxLib::grow(bx,1).d_numPts() - bx.d_numPts());
+
+    return work;
+}
+
+Array<Array<long> >
+Amr::estimateBoxWork (const Array<BoxArray>& allBoxes) const
+{
+    Array<Array<long> > work;
+
+    if (!calibrate_work || work_per_cell[0] <= 0)
+        return work;
+
+    work.resize(allBoxes.size());
+
+    const Real unit = work_per_cell[0];
+
+    Real steps = 1;
+
+    for (int lev = 0; lev < allBoxes.size(); lev++)
+    {
+        if (lev > 0 && sub_cycle)
+            steps *= std::max(1, n_cycle[lev]);
+
+        const BoxArray& ba = allBoxes[lev];
+
+        work[lev].resize(ba.size());
+
+        for (int i = 0, N = ba.size(); i < N; i++)
+            work[lev][i] = std::max(1L, long(steps*estimateWork(lev,ba[i])/unit + 0.5));
+    }
+
+    return work;
+}
+
 const Array<BoxArray>& Amr::getInitialBA()
 {
   return initial_ba;
@@ -3681,11 +3957,13 @@ Amr::RedistributeGrids(int how) {
         }
         Array<Array<int> > mLDM;
         if(how == 1) {
-          mLDM = DistributionMapping::MultiLevelMapPFC(ref_ratio, allBoxes, maxGridSize(0));
+          mLDM = DistributionMapping::MultiLevelMapPFC(ref_ratio, allBoxes, maxGridSize(0),
+                                                       estimateBoxWork(allBoxes));
         } else if(how == 2) {
           mLDM = DistributionMapping::MultiLevelMapRandom(ref_ratio, allBoxes, maxGridSize(0));
         } else if(how == 3) {
-          mLDM = DistributionMapping::MultiLevelMapKnapSack(ref_ratio, allBoxes, maxGridSize(0));
+          mLDM = DistributionMapping::MultiLevelMapKnapSack(ref_ratio, allBoxes, maxGridSize(0),
+                                                            estimateBoxWork(allBoxes));
         } else if(how == 0) {   // ---- move all grids to proc zero
 	  int minRank(0), maxRank(0);
           mLDM = DistributionMapping::MultiLevelMapRandom(ref_ratio, allBoxes, maxGridSize(0),
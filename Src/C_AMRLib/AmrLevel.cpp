@@ -1,5 +1,7 @@
 
 #include <winstd.H>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include <unistd.h>
@@ -61,6 +63,12 @@ AmrLevel::manual_tags_placement (TagBoxArray&    tags,
 {}
 
 AmrLevel::AmrLevel ()
+    :
+    fp_recording(false),
+    fp_record_time(0),
+    fp_prefetch_time(0),
+    fp_prefetch_hits(0),
+    fp_prefetch_misses(0)
 {
    parent = 0;
    level = -1;
@@ -73,7 +81,12 @@ AmrLevel::AmrLevel (Amr&            papa,
                     Real            time)
     :
     geom(level_geom),
-    grids(ba)
+    grids(ba),
+    fp_recording(false),
+    fp_record_time(0),
+    fp_prefetch_time(0),
+    fp_prefetch_hits(0),
+    fp_prefetch_misses(0)
 {
     BL_PROFILE("AmrLevel::AmrLevel()");
     level  = lev;
@@ -116,7 +129,12 @@ AmrLevel::AmrLevel (Amr&            papa,
                     Real            time)
     :
     geom(level_geom),
-    grids(ba)
+    grids(ba),
+    fp_recording(false),
+    fp_record_time(0),
+    fp_prefetch_time(0),
+    fp_prefetch_hits(0),
+    fp_prefetch_misses(0)
 {
     BL_PROFILE("AmrLevel::AmrLevel(dm)");
     level  = lev;
@@ -313,6 +331,8 @@ AmrLevel::checkPoint (const std::string& dir,
 
 AmrLevel::~AmrLevel ()
 {
+    clearPrefetch();
+    clearFillPatchData();
     parent = 0;
 }
 
@@ -412,6 +432,8 @@ FillPatchIterator::FillPatchIterator (AmrLevel& amrlevel,
     MFIter(leveldata),
     m_amrlevel(amrlevel),
     m_leveldata(leveldata),
+    m_fabs(0),
+    m_fpdata(0),
     m_ncomp(0)
 {}
 
@@ -447,6 +469,8 @@ FillPatchIterator::FillPatchIterator (AmrLevel& amrlevel,
     MFIter(leveldata),
     m_amrlevel(amrlevel),
     m_leveldata(leveldata),
+    m_fabs(0),
+    m_fpdata(0),
     m_ncomp(ncomp)
 {
     BL_ASSERT(scomp >= 0);
@@ -748,9 +772,31 @@ FillPatchIterator::Initialize (int  boxGrow,
     m_ncomp = ncomp;
     m_range = desc.sameInterps(scomp,ncomp);
 
-    m_fabs.define(m_leveldata.boxArray(),m_ncomp,boxGrow,Fab_allocate);
+    const AmrLevel::FillPatchKey key = { boxGrow, index, scomp, ncomp };
+
+    if (m_fpdata)
+        m_fpdata->in_use = false;
+    else
+        delete m_fabs;
+
+    m_fpdata = m_amrlevel.getFillPatchData(key, m_leveldata, m_range.size());
+
+    if (m_fpdata)
+        m_fabs = m_fpdata->fabs;
+    else
+        m_fabs = new MultiFab(m_leveldata.boxArray(),m_ncomp,boxGrow,Fab_allocate);
+
+    BL_ASSERT(m_leveldata.DistributionMap() == m_fabs->DistributionMap());
+
+    m_amrlevel.recordFillPatch(key, time);
+
+    const Real strt = m_amrlevel.parent->calibratingWork() ? ParallelDescriptor::second() : 0;
 
-    BL_ASSERT(m_leveldata.DistributionMap() == m_fabs.DistributionMap());
+    if (FillFromPrefetch(boxGrow, time, index, scomp, ncomp))
+    {
+        RecordWork(boxGrow, strt);
+        return;
+    }
 
     const IndexType& boxType = m_leveldata.boxArray().ixType();
     const int level = m_amrlevel.level;
@@ -771,7 +817,8 @@ FillPatchIterator::Initialize (int  boxGrow,
 				       m_amrlevel.parent->blockingFactor(m_amrlevel.level),
 				       boxGrow, boxType, desc.interp(SComp)))
 	    {
-		FillFromTwoLevels(time, index, SComp, DComp, NComp);
+		FillFromTwoLevels(time, index, SComp, DComp, NComp,
+				  m_fpdata ? &m_fpdata->plans[i] : 0);
 	    } else {
 		static bool first = true;
 		if (first) {
@@ -813,9 +860,9 @@ FillPatchIterator::Initialize (int  boxGrow,
 #pragma omp parallel
 #endif
 #endif
-		for (MFIter mfi(m_fabs); mfi.isValid(); ++mfi)
+		for (MFIter mfi(*m_fabs); mfi.isValid(); ++mfi)
 		{
-		    fph->fill(m_fabs[mfi],DComp,mfi.index());
+		    fph->fill((*m_fabs)[mfi],DComp,mfi.index());
 		}
 		
 		delete fph;
@@ -827,12 +874,41 @@ FillPatchIterator::Initialize (int  boxGrow,
     //
     // Call hack to touch up fillPatched data.
     //
-    m_amrlevel.set_preferred_boundary_values(m_fabs,
+    m_amrlevel.set_preferred_boundary_values(*m_fabs,
                                              index,
                                              scomp,
                                              0,
                                              ncomp,
                                              time);
+
+    RecordWork(boxGrow, strt);
+}
+
+void
+FillPatchIterator::RecordWork (int  boxGrow,
+                               Real strt)
+{
+    if (!m_amrlevel.parent->calibratingWork()) return;
+
+    const Real seconds = ParallelDescriptor::second() - strt;
+
+    const BoxArray&            ba = m_fabs->boxArray();
+    const DistributionMapping& dm = m_fabs->DistributionMap();
+    const int                  MyProc = ParallelDescriptor::MyProc();
+
+    Real nghost = 0;
+
+    for (int i = 0, N = ba.size(); i < N; i++)
+    {
+        if (dm[i] == MyProc)
+        {
+            const Box& bx = ba[i];
+
+            nghost += BoxLib::grow(bx,boxGrow).d_numPts() - bx.d_numPts();
+        }
+    }
+
+    m_amrlevel.parent->recordFillPatchWork(m_amrlevel.level, seconds, nghost*m_ncomp);
 }
 
 void
@@ -850,11 +926,95 @@ FillPatchIterator::FillFromLevel0 (Real time, int index, int scomp, int dcomp, i
 
     StateDataPhysBCFunct physbcf(statedata,scomp,geom);
 
-    BoxLib::FillPatchSingleLevel (m_fabs, time, smf, stime, scomp, dcomp, ncomp, geom, physbcf);
+    BoxLib::FillPatchSingleLevel (*m_fabs, time, smf, stime, scomp, dcomp, ncomp, geom, physbcf);
+}
+
+bool
+FillPatchIterator::FillFromPrefetch (int boxGrow, Real time, int index, int scomp, int ncomp)
+{
+    const AmrLevel::FillPatchKey key = { boxGrow, index, scomp, ncomp };
+
+    MultiFab* pf = m_amrlevel.takePrefetchedFillPatch(key, time);
+
+    if (pf == 0) return false;
+
+    BL_PROFILE("FillPatchIterator::FillFromPrefetch");
+
+    if (pf->boxArray() != m_fabs->boxArray() || pf->DistributionMap() != m_fabs->DistributionMap())
+    {
+        m_amrlevel.fp_prefetch_misses++;
+        delete pf;
+        return false;
+    }
+
+    m_amrlevel.fp_prefetch_hits++;
+    //
+    // The prefetched fill has the valid data and the ghost cells covered
+    // by this level; add the coarse/fine and physical boundaries.
+    //
+    MultiFab::Copy(*m_fabs, *pf, 0, 0, ncomp, boxGrow);
+
+    delete pf;
+
+    const int       level     = m_amrlevel.level;
+    const Geometry& geom      = m_amrlevel.geom;
+    StateData&      statedata = m_amrlevel.state[index];
+
+    if (level > 0)
+    {
+        AmrLevel&              crse_level     = m_amrlevel.parent->getLevel(level-1);
+        StateData&             statedata_crse = crse_level.state[index];
+        const StateDescriptor& desc           = AmrLevel::desc_lst[index];
+
+        PArray<MultiFab> smf_crse, smf_fine;
+        std::vector<Real> stime_crse, stime_fine;
+        statedata_crse.getData(smf_crse,stime_crse,time);
+        statedata.getData(smf_fine,stime_fine,time);
+
+        for (int i = 0, DComp = 0; i < m_range.size(); i++)
+        {
+            const int SComp = m_range[i].first;
+            const int NComp = m_range[i].second;
+
+            StateDataPhysBCFunct physbcf_crse(statedata_crse,SComp,crse_level.geom);
+
+            BoxLib::FillCoarsePatch(*m_fabs, time, smf_crse, stime_crse, smf_fine[0],
+                                    SComp, DComp, NComp, crse_level.geom, geom,
+                                    physbcf_crse, crse_level.fineRatio(),
+                                    desc.interp(SComp), desc.getBCs(),
+                                    m_fpdata ? &m_fpdata->plans[i] : 0);
+            DComp += NComp;
+        }
+        //
+        // The coarse patch also covers the periodic images of this level.
+        //
+        m_fabs->EnforcePeriodicity(geom.periodicity());
+    }
+
+    for (int i = 0, DComp = 0; i < m_range.size(); i++)
+    {
+        const int SComp = m_range[i].first;
+        const int NComp = m_range[i].second;
+
+        StateDataPhysBCFunct physbcf(statedata,SComp,geom);
+
+        physbcf.FillBoundary(*m_fabs, DComp, NComp, time);
+
+        DComp += NComp;
+    }
+
+    m_amrlevel.set_preferred_boundary_values(*m_fabs,
+                                             index,
+                                             scomp,
+                                             0,
+                                             ncomp,
+                                             time);
+    return true;
 }
 
 void
-FillPatchIterator::FillFromTwoLevels (Real time, int index, int scomp, int dcomp, int ncomp)
+FillPatchIterator::FillFromTwoLevels (Real time, int index, int scomp, int dcomp, int ncomp,
+                                      FillPatchPlan* plan)
 {
     int ilev_fine = m_amrlevel.level;
     int ilev_crse = ilev_fine-1;
@@ -881,14 +1041,14 @@ FillPatchIterator::FillFromTwoLevels (Real time, int index, int scomp, int dcomp
 
     const StateDescriptor& desc = AmrLevel::desc_lst[index];
 
-    BoxLib::FillPatchTwoLevels(m_fabs, time, 
+    BoxLib::FillPatchTwoLevels(*m_fabs, time, 
 			       smf_crse, stime_crse, 
 			       smf_fine, stime_fine,
 			       scomp, dcomp, ncomp, 
 			       geom_crse, geom_fine,
 			       physbcf_crse, physbcf_fine,
 			       crse_level.fineRatio(), 
-			       desc.interp(scomp), desc.getBCs());
+			       desc.interp(scomp), desc.getBCs(), plan);
 }
 
 static
@@ -1247,7 +1407,13 @@ FillPatchIteratorHelper::fill (FArrayBox& fab,
 
 FillPatchIteratorHelper::~FillPatchIteratorHelper () {}
 
-FillPatchIterator::~FillPatchIterator () {}
+FillPatchIterator::~FillPatchIterator ()
+{
+    if (m_fpdata)
+        m_fpdata->in_use = false;
+    else
+        delete m_fabs;
+}
 
 void
 AmrLevel::FillCoarsePatch (MultiFab& mf,
@@ -1630,6 +1796,270 @@ AmrLevel::derive (const std::string& name,
     }
 }
 
+void
+AmrLevel::deriveBatch (const std::vector<std::string>& names,
+                       Real                            time,
+                       MultiFab&                       mf,
+                       int                             dcomp)
+{
+    BL_PROFILE("AmrLevel::deriveBatch()");
+
+    const int ngrow  = mf.nGrow();
+    const int nnames = names.size();
+    const int ntyp   = desc_lst.size();
+    //
+    // What each name is, where it goes in mf and how many ghost cells of
+    // its state data it needs.
+    //
+    std::vector<const DeriveRec*> recs(nnames, static_cast<const DeriveRec*>(0));
+    std::vector<int>              state_index(nnames,-1), state_comp(nnames,-1), direct(nnames,0);
+    std::vector<int>              dst_comp(nnames), src_ngrow(nnames,ngrow);
+    //
+    // The components of each state type needed and the most ghost cells.
+    //
+    std::vector<std::vector<int> > needed(ntyp);
+    std::vector<int>               typ_ngrow(ntyp,-1);
+
+    int index, scomp, ncomp;
+
+    for (int i = 0, dc = dcomp; i < nnames; i++)
+    {
+        dst_comp[i] = dc;
+
+        if (isStateVariable(names[i], index, scomp))
+        {
+            state_index[i] = index;
+            state_comp[i]  = scomp;
+            dc++;
+            //
+            // mf isn't on the state's grids; fill it directly.
+            //
+            if (mf.boxArray() != state[index].boxArray())
+            {
+                direct[i] = 1;
+                continue;
+            }
+
+            if (needed[index].empty())
+                needed[index].resize(desc_lst[index].nComp(),0);
+            needed[index][scomp] = 1;
+            typ_ngrow[index] = std::max(typ_ngrow[index], ngrow);
+        }
+        else if (const DeriveRec* rec = derive_lst.get(names[i]))
+        {
+            recs[i] = rec;
+
+            rec->getRange(0, index, scomp, ncomp);
+
+            const BoxArray& srcBA = state[index].boxArray();
+
+            BL_ASSERT(mf.boxArray().CellEqual(srcBA));
+            {
+                Box bx0 = srcBA[0];
+                Box bx1 = rec->boxMap()(bx0);
+                src_ngrow[i] += bx0.smallEnd(0) - bx1.smallEnd(0);
+            }
+
+            for (int k = 0; k < rec->numRange(); k++)
+            {
+                rec->getRange(k, index, scomp, ncomp);
+                if (needed[index].empty())
+                    needed[index].resize(desc_lst[index].nComp(),0);
+                for (int n = scomp; n < scomp+ncomp; n++)
+                    needed[index][n] = 1;
+                typ_ngrow[index] = std::max(typ_ngrow[index], src_ngrow[i]);
+            }
+
+            dc += rec->numDerive();
+        }
+        else
+        {
+            dc++;
+        }
+    }
+
+    BL_ASSERT(nnames == 0 || dst_comp[nnames-1] < mf.nComp());
+    //
+    // One FillPatch per run of needed components of each state type.
+    // pos[typ][comp] is where comp of typ lives in src[typ].
+    //
+    PArray<MultiFab>               src(ntyp, PArrayManage);
+    std::vector<std::vector<int> > pos(ntyp);
+
+    for (int typ = 0; typ < ntyp; typ++)
+    {
+        if (needed[typ].empty()) continue;
+
+        const int nc = needed[typ].size();
+
+        pos[typ].resize(nc,-1);
+
+        int nsrc = 0;
+        for (int n = 0; n < nc; n++)
+            if (needed[typ][n])
+                pos[typ][n] = nsrc++;
+
+        src.set(typ, new MultiFab(state[typ].boxArray(), nsrc, typ_ngrow[typ],
+                                  mf.DistributionMap(), Fab_allocate));
+
+        for (int n = 0; n < nc; )
+        {
+            if (!needed[typ][n]) { n++; continue; }
+
+            int m = n;
+            while (m < nc && needed[typ][m]) m++;
+
+            FillPatch(*this,src[typ],typ_ngrow[typ],time,typ,n,m-n,pos[typ][n]);
+
+            n = m;
+        }
+    }
+
+    //
+    // A rec whose components are all of one state type and sit next to
+    // each other, in its order, in src can read src directly.
+    //
+    std::vector<int> src_start(nnames,-1);
+
+    for (int i = 0; i < nnames; i++)
+    {
+        const DeriveRec* rec = recs[i];
+
+        if (rec == 0) continue;
+
+        int typ, start;
+
+        rec->getRange(0, typ, scomp, ncomp);
+
+        start = pos[typ][scomp];
+
+        bool contiguous = true;
+
+        for (int k = 0, dc = 0; k < rec->numRange() && contiguous; k++, dc += ncomp)
+        {
+            rec->getRange(k, index, scomp, ncomp);
+            for (int n = 0; n < ncomp; n++)
+                if (index != typ || pos[index][scomp+n] != start+dc+n)
+                    contiguous = false;
+        }
+
+        if (contiguous)
+            src_start[i] = start;
+    }
+
+    for (int i = 0; i < nnames; i++)
+    {
+        if (state_index[i] >= 0)
+        {
+            const int typ = state_index[i];
+            if (direct[i])
+                FillPatch(*this,mf,ngrow,time,typ,state_comp[i],1,dst_comp[i]);
+            else
+                MultiFab::Copy(mf,src[typ],pos[typ][state_comp[i]],dst_comp[i],1,ngrow);
+        }
+        else if (recs[i] == 0)
+        {
+            derive(names[i],time,mf,dst_comp[i]);
+        }
+    }
+
+    const Real* dx = geom.CellSize();
+    const Real  dt = parent->dtLevel(level);
+
+#if defined(CRSEGRNDOMP) && defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+        FArrayBox cfab;
+
+#ifdef CRSEGRNDOMP
+        for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+#else
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+#endif
+        {
+            int         idx  = mfi.index();
+#ifdef CRSEGRNDOMP
+            const Box&  bx   = mfi.growntilebox();
+#else
+            const Box&  bx   = mf[mfi].box();
+#endif
+            const int*  lo   = bx.loVect();
+            const int*  hi   = bx.hiVect();
+            const int*  dlo  = mf[mfi].loVect();
+            const int*  dhi  = mf[mfi].hiVect();
+            const RealBox& temp = RealBox(bx,geom.CellSize(),geom.ProbLo());
+            const Real* xlo  = temp.lo();
+
+            for (int i = 0; i < nnames; i++)
+            {
+                const DeriveRec* rec = recs[i];
+
+                if (rec == 0) continue;
+                rec->getRange(0, index, scomp, ncomp);
+
+                Real*       cdat;
+                const int*  clo;
+                const int*  chi;
+
+                if (src_start[i] >= 0)
+                {
+                    FArrayBox& sfab = src[index][mfi];
+
+                    cdat = sfab.dataPtr(src_start[i]);
+                    clo  = sfab.loVect();
+                    chi  = sfab.hiVect();
+                }
+                else
+                {
+                    //
+                    // Gather the rec's state components, in its order, on
+                    // just the part of the source this box reads.
+                    //
+                    const Box cbx = BoxLib::grow(bx, src_ngrow[i]-ngrow);
+
+                    cfab.resize(cbx, rec->numState());
+
+                    for (int k = 0, dc = 0; k < rec->numRange(); k++, dc += ncomp)
+                    {
+                        rec->getRange(k, index, scomp, ncomp);
+                        cfab.copy(src[index][mfi], cbx, pos[index][scomp], cbx, dc, ncomp);
+                    }
+
+                    cdat = cfab.dataPtr();
+                    clo  = cfab.loVect();
+                    chi  = cfab.hiVect();
+                }
+
+                Real*       ddat    = mf[mfi].dataPtr(dst_comp[i]);
+                int         n_der   = rec->numDerive();
+                int         n_state = rec->numState();
+                const int*  dom_lo  = state[index].getDomain().loVect();
+                const int*  dom_hi  = state[index].getDomain().hiVect();
+                const int*  bcr     = rec->getBC();
+
+                if (rec->derFunc() != static_cast<DeriveFunc>(0)){
+                    rec->derFunc()(ddat,ARLIM(dlo),ARLIM(dhi),&n_der,
+                                   cdat,ARLIM(clo),ARLIM(chi),&n_state,
+                                   lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
+                                   &level,&idx);
+                } else if (rec->derFunc3D() != static_cast<DeriveFunc3D>(0)){
+                    rec->derFunc3D()(ddat,ARLIM_3D(dlo),ARLIM_3D(dhi),&n_der,
+                                     cdat,ARLIM_3D(clo),ARLIM_3D(chi),&n_state,
+                                     ARLIM_3D(lo),ARLIM_3D(hi),
+                                     ARLIM_3D(dom_lo),ARLIM_3D(dom_hi),
+                                     ZFILL(dx),ZFILL(xlo),
+                                     &time,&dt,
+                                     BCREC_3D(bcr),
+                                     &level,&idx);
+                } else {
+                    BoxLib::Error("AmrLevel::deriveBatch: no function available");
+                }
+            }
+        }
+    }
+}
+
 Array<int>
 AmrLevel::getBCArray (int State_Type,
                       int gridno,
@@ -1782,7 +2212,12 @@ AmrLevel::which_time (int  indx,
 Real
 AmrLevel::estimateWork ()
 {
-    return 1.0*countCells();
+    Real work = 0;
+
+    for (int i = 0; i < grids.size(); i++)
+        work += parent->estimateWork(level,grids[i]);
+
+    return work;
 }
 
 bool
@@ -1865,6 +2300,205 @@ AmrLevel::FillPatch(AmrLevel& amrlevel,
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+void
+AmrLevel::prefetchAdvance (Real time,
+                           Real dt,
+                           int  iteration,
+                           int  ncycle)
+{
+    for (int i = 0; i < fp_record.size(); ++i)
+    {
+        const FillPatchKey& key = fp_record[i];
+
+        prefetchFillPatch(key.boxGrow, time, key.index, key.scomp, key.ncomp);
+    }
+}
+
+void
+AmrLevel::prefetchFillPatch (int  boxGrow,
+                             Real time,
+                             int  index,
+                             int  scomp,
+                             int  ncomp)
+{
+    BL_PROFILE("AmrLevel::prefetchFillPatch()");
+
+    BL_ASSERT(0 <= index && index < desc_lst.size());
+    BL_ASSERT(desc_lst[index].inRange(scomp,ncomp));
+    //
+    // The one-sided FillBoundary uses a single window, so only one
+    // exchange can be in flight.
+    //
+    if (ParallelDescriptor::MPIOneSided()) return;
+
+    if (!fp_prefetch.empty() && !sameFillPatchTime(fp_prefetch_time, time)) clearPrefetch();
+
+    const FillPatchKey key = { boxGrow, index, scomp, ncomp };
+
+    if (std::find(fp_prefetch_key.begin(), fp_prefetch_key.end(), key) != fp_prefetch_key.end())
+        return;
+
+    PArray<MultiFab> smf;
+    std::vector<Real> stime;
+    state[index].getData(smf,stime,time);
+    //
+    // Only a fill from a single time level reduces to a FillBoundary.
+    //
+    if (smf.size() != 1) return;
+
+    if (level > 1)
+    {
+        const StateDescriptor& desc = desc_lst[index];
+        const std::vector< std::pair<int,int> >& range = desc.sameInterps(scomp,ncomp);
+
+        for (int i = 0; i < range.size(); ++i)
+        {
+            if (!BoxLib::ProperlyNested(crse_ratio, parent->blockingFactor(level), boxGrow,
+                                        smf[0].boxArray().ixType(), desc.interp(range[i].first)))
+                return;
+        }
+    }
+
+    MultiFab* mf = new MultiFab(smf[0].boxArray(), ncomp, boxGrow, smf[0].DistributionMap());
+
+    MultiFab::Copy(*mf, smf[0], scomp, 0, ncomp, 0);
+
+    mf->FillBoundary_nowait(0, ncomp, geom.periodicity());
+
+    fp_prefetch_key.push_back(key);
+    fp_prefetch.push_back(mf);
+    fp_prefetch_time = time;
+}
+
+void
+AmrLevel::recordFillPatches (bool on,
+                             Real time)
+{
+    if (on) fp_record.clear();
+
+    fp_recording   = on;
+    fp_record_time = time;
+}
+
+void
+AmrLevel::recordFillPatch (const FillPatchKey& key,
+                           Real                time)
+{
+    if (fp_recording && sameFillPatchTime(time, fp_record_time) &&
+        std::find(fp_record.begin(), fp_record.end(), key) == fp_record.end())
+    {
+        fp_record.push_back(key);
+    }
+}
+
+MultiFab*
+AmrLevel::takePrefetchedFillPatch (const FillPatchKey& key,
+                                   Real                time)
+{
+    if (fp_prefetch.empty() || !sameFillPatchTime(time, fp_prefetch_time)) return 0;
+
+    for (int i = 0; i < fp_prefetch.size(); ++i)
+    {
+        if (fp_prefetch_key[i] == key)
+        {
+            MultiFab* mf = fp_prefetch[i];
+
+            mf->FillBoundary_finish();
+
+            fp_prefetch.erase(fp_prefetch.begin() + i);
+            fp_prefetch_key.erase(fp_prefetch_key.begin() + i);
+
+            return mf;
+        }
+    }
+
+    return 0;
+}
+
+bool
+AmrLevel::sameFillPatchTime (Real t1,
+                             Real t2) const
+{
+    //
+    // The same tolerance as StateData::getData(); the finer levels'
+    // times are accumulated so may not match exactly.
+    //
+    const Real teps = parent->dtLevel(level)*1.e-3;
+
+    return std::abs(t1 - t2) <= teps;
+}
+
+AmrLevel::FillPatchData*
+AmrLevel::getFillPatchData (const FillPatchKey& key,
+                            const MultiFab&     leveldata,
+                            int                 nplans)
+{
+    if (!Amr::FillPatch_Plans()) return 0;
+
+    FillPatchData* fpd = 0;
+
+    for (int i = 0; i < fp_data.size() && fpd == 0; ++i)
+    {
+        if (fp_data[i]->key == key && !fp_data[i]->in_use) fpd = fp_data[i];
+    }
+
+    if (fpd == 0)
+    {
+        fpd = new FillPatchData;
+        fpd->key = key;
+        fp_data.push_back(fpd);
+    }
+
+    if (fpd->fabs == 0 ||
+        fpd->fabs->boxArray()        != leveldata.boxArray() ||
+        fpd->fabs->DistributionMap() != leveldata.DistributionMap())
+    {
+        delete fpd->fabs;
+        fpd->fabs = new MultiFab(leveldata.boxArray(), key.ncomp, key.boxGrow,
+                                 leveldata.DistributionMap());
+        fpd->plans.clear();
+    }
+
+    while (fpd->plans.size() < nplans)
+        fpd->plans.push_back(new FillPatchPlan);
+
+    fpd->in_use = true;
+
+    return fpd;
+}
+
+void
+AmrLevel::clearFillPatchData ()
+{
+    for (int i = 0; i < fp_data.size(); ++i)
+    {
+        BL_ASSERT(!fp_data[i]->in_use);
+        delete fp_data[i];
+    }
+    fp_data.clear();
+}
+
+void
+AmrLevel::clearPrefetch ()
+{
+    fp_prefetch_misses += fp_prefetch.size();
+
+    if (!fp_prefetch.empty() && parent->Verbose() > 1 && ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "AmrLevel " << level << ": " << fp_prefetch.size()
+                  << " prefetched FillPatch(es) unused (" << fp_prefetch_hits
+                  << " used, " << fp_prefetch_misses << " unused so far)\n";
+    }
+
+    for (int i = 0; i < fp_prefetch.size(); ++i)
+    {
+        fp_prefetch[i]->FillBoundary_finish();
+        delete fp_prefetch[i];
+    }
+    fp_prefetch.clear();
+    fp_prefetch_key.clear();
+}
+
 
 
 void
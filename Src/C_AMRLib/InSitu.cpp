@@ -0,0 +1,513 @@
+
+#include <winstd.H>
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+#include <Amr.H>
+#include <AmrLevel.H>
+#include <InSitu.H>
+#include <ParmParse.H>
+#include <Utility.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+InSituRec::InSituRec ()
+    :
+    type(Slice),
+    interval(1),
+    dir(-1),
+    level(0),
+    nbins(0),
+    hmin(0),
+    hmax(0),
+    cpu(0)
+{
+    D_TERM(coord[0],=coord[1],=coord[2]) = 0;
+}
+
+namespace
+{
+    //
+    // The number of components deriveBatch() gives var.
+    //
+    int
+    NumComp (const std::string& var)
+    {
+        int typ, comp;
+
+        if (AmrLevel::isStateVariable(var,typ,comp))
+            return 1;
+
+        return AmrLevel::get_derive_lst().get(var)->numDerive();
+    }
+    //
+    // Index of the cell containing x in direction d of geom's domain.
+    //
+    int
+    CellIndex (const Geometry& geom, int d, Real x)
+    {
+        const Box& domain = geom.Domain();
+
+        int i = int(std::floor((x - Geometry::ProbLo(d)) / geom.CellSize(d)));
+
+        return std::max(domain.smallEnd(d), std::min(domain.bigEnd(d), i));
+    }
+}
+
+void
+InSitu::init (const Amr& amr)
+{
+    ParmParse pp("insitu");
+
+    m_rec.clear();
+
+    if (!pp.contains("diags")) return;
+
+    m_dir = "InSitu";
+    pp.query("dir", m_dir);
+
+    int interval = 1;
+    pp.query("int", interval);
+
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    int nagg = 1;
+    pp.query("naggregators", nagg);
+    nagg = std::max(1, std::min(nagg, nprocs));
+
+    const int N = pp.countval("diags");
+
+    m_rec.resize(N);
+
+    for (int i = 0; i < N; i++)
+    {
+        InSituRec& rec = m_rec[i];
+
+        pp.get("diags", rec.name, i);
+
+        ParmParse ppr(std::string("insitu.") + rec.name);
+
+        std::string type;
+        ppr.get("type", type);
+
+        if (type == "slice")
+            rec.type = InSituRec::Slice;
+        else if (type == "probe")
+            rec.type = InSituRec::Probe;
+        else if (type == "histogram")
+            rec.type = InSituRec::Histogram;
+        else if (type == "average")
+            rec.type = InSituRec::Average;
+        else
+        {
+            std::string msg("InSitu::init(): unknown type `");
+            msg += type + "' for " + rec.name;
+            BoxLib::Abort(msg.c_str());
+        }
+
+        const int nv = ppr.countval("vars");
+
+        if (nv <= 0)
+        {
+            std::string msg("InSitu::init(): no vars for ");
+            msg += rec.name;
+            BoxLib::Abort(msg.c_str());
+        }
+
+        rec.vars.resize(nv);
+
+        for (int n = 0; n < nv; n++)
+        {
+            ppr.get("vars", rec.vars[n], n);
+
+            int typ, comp;
+
+            if (!AmrLevel::isStateVariable(rec.vars[n],typ,comp) &&
+                !AmrLevel::get_derive_lst().canDerive(rec.vars[n]))
+            {
+                std::string msg("InSitu::init(): `");
+                msg += rec.vars[n] + "' is not a state or derived variable";
+                BoxLib::Abort(msg.c_str());
+            }
+        }
+
+        rec.interval = interval;
+        ppr.query("int", rec.interval);
+
+        ppr.query("level", rec.level);
+        rec.level = std::max(0, rec.level);
+
+        switch (rec.type)
+        {
+        case InSituRec::Slice:
+            ppr.get("dir", rec.dir);
+            ppr.get("coord", rec.coord[rec.dir]);
+            break;
+        case InSituRec::Probe:
+        {
+            ppr.get("dir", rec.dir);
+            Array<Real> x(BL_SPACEDIM);
+            ppr.getarr("coord", x, 0, BL_SPACEDIM);
+            for (int d = 0; d < BL_SPACEDIM; d++)
+                rec.coord[d] = x[d];
+            break;
+        }
+        case InSituRec::Histogram:
+            if (nv != 1)
+                BoxLib::Abort("InSitu::init(): a histogram takes one var");
+            ppr.get("nbins", rec.nbins);
+            ppr.get("min", rec.hmin);
+            ppr.get("max", rec.hmax);
+            if (rec.nbins <= 0 || rec.hmax <= rec.hmin)
+                BoxLib::Abort("InSitu::init(): bad histogram nbins, min or max");
+            break;
+        case InSituRec::Average:
+            ppr.query("dir", rec.dir);
+            break;
+        }
+
+        if (rec.type != InSituRec::Histogram && rec.dir >= BL_SPACEDIM)
+            BoxLib::Abort("InSitu::init(): bad dir");
+
+        if ((rec.type == InSituRec::Slice || rec.type == InSituRec::Probe) && rec.dir < 0)
+            BoxLib::Abort("InSitu::init(): bad dir");
+        //
+        // Spread the diagnostics over the aggregators.
+        //
+        rec.cpu = (i % nagg) * (nprocs / nagg);
+    }
+    //
+    // Only the I/O processor makes the directory if it doesn't exist.
+    //
+    if (ParallelDescriptor::IOProcessor())
+        if (!BoxLib::UtilCreateDirectory(m_dir, 0755))
+            BoxLib::CreateDirectoryFailed(m_dir);
+    //
+    // Everyone must wait till directory is built.
+    //
+    ParallelDescriptor::Barrier();
+}
+
+void
+InSitu::report (Amr& amr,
+                int  step,
+                Real time)
+{
+    std::vector<int> due;
+
+    for (int i = 0; i < m_rec.size(); i++)
+        if (m_rec[i].interval > 0 && step % m_rec[i].interval == 0)
+            due.push_back(i);
+
+    if (due.empty()) return;
+
+    BL_PROFILE("InSitu::report()");
+    //
+    // Every variable the diagnostics need, once, and where it starts.
+    //
+    std::vector<std::string> names;
+    std::vector<int>         start;
+    int                      ncomp = 0;
+
+    for (int i = 0; i < due.size(); i++)
+    {
+        const InSituRec& rec = m_rec[due[i]];
+
+        for (int n = 0; n < rec.vars.size(); n++)
+        {
+            if (std::find(names.begin(), names.end(), rec.vars[n]) == names.end())
+            {
+                names.push_back(rec.vars[n]);
+                start.push_back(ncomp);
+                ncomp += NumComp(rec.vars[n]);
+            }
+        }
+    }
+    //
+    // Slices and probes read only up to their own level; histograms and
+    // averages read them all.
+    //
+    const int finest = amr.finestLevel();
+
+    int top = 0;
+
+    for (int i = 0; i < due.size(); i++)
+    {
+        const InSituRec& rec = m_rec[due[i]];
+
+        if (rec.type == InSituRec::Slice || rec.type == InSituRec::Probe)
+            top = std::max(top, std::min(rec.level, finest));
+        else
+            top = finest;
+    }
+    //
+    // One deriveBatch per level gets all of them.
+    //
+    PArray<MultiFab> data(top+1, PArrayManage);
+
+    for (int lev = 0; lev <= top; lev++)
+    {
+        data.set(lev, new MultiFab(amr.getLevel(lev).boxArray(), ncomp, 0));
+
+        amr.getLevel(lev).deriveBatch(names, time, data[lev], 0);
+    }
+
+    for (int i = 0; i < due.size(); i++)
+    {
+        const InSituRec& rec = m_rec[due[i]];
+
+        std::vector<int> comps(rec.vars.size());
+
+        for (int n = 0; n < rec.vars.size(); n++)
+        {
+            const int k = std::find(names.begin(), names.end(), rec.vars[n]) - names.begin();
+            comps[n] = start[k];
+        }
+
+        if (rec.type == InSituRec::Slice || rec.type == InSituRec::Probe)
+            sample(amr, rec, data, comps, step, time);
+        else
+            reduce(amr, rec, data, comps, step, time);
+    }
+}
+
+void
+InSitu::sample (const Amr&              amr,
+                const InSituRec&        rec,
+                const PArray<MultiFab>& data,
+                const std::vector<int>& comps,
+                int                     step,
+                Real                    time) const
+{
+    const int       lev  = std::min(rec.level, amr.finestLevel());
+    const Geometry& geom = amr.Geom(lev);
+    const int       nv   = comps.size();
+    //
+    // The cells of the slice or line at lev.
+    //
+    Box sbx = geom.Domain();
+
+    for (int d = 0; d < BL_SPACEDIM; d++)
+    {
+        if ((rec.type == InSituRec::Slice && d == rec.dir) ||
+            (rec.type == InSituRec::Probe && d != rec.dir))
+        {
+            const int i = CellIndex(geom, d, rec.coord[d]);
+            sbx.setSmall(d, i);
+            sbx.setBig(d, i);
+        }
+    }
+
+    const bool iwrite = (ParallelDescriptor::MyProc() == rec.cpu);
+
+    FArrayBox fab;
+
+    if (iwrite)
+    {
+        fab.resize(sbx, nv);
+        fab.setVal(0);
+    }
+    //
+    // Gather each level onto the aggregator, coarse to fine, injecting
+    // the data on the grids of each level.
+    //
+    Array<int> pmap(2);
+    pmap[0] = rec.cpu;
+    pmap[1] = ParallelDescriptor::MyProc();
+
+    const DistributionMapping dm(pmap);
+
+    for (int l = 0; l <= lev; l++)
+    {
+        IntVect rr = IntVect::TheUnitVector();
+        for (int k = l; k < lev; k++)
+            rr *= amr.refRatio(k);
+
+        const Box cbx = BoxLib::coarsen(sbx, rr);
+
+        MultiFab smf(BoxArray(cbx), nv, 0, dm, Fab_allocate);
+
+        for (int n = 0; n < nv; n++)
+            smf.copy(data[l], comps[n], n, 1);
+
+        if (iwrite)
+        {
+            const FArrayBox& cfab = smf[0];
+
+            const std::vector< std::pair<int,Box> >& isects = data[l].boxArray().intersections(cbx);
+
+            for (int k = 0; k < isects.size(); k++)
+            {
+                const Box fbx = BoxLib::refine(isects[k].second, rr) & sbx;
+
+                for (IntVect iv = fbx.smallEnd(); iv <= fbx.bigEnd(); fbx.next(iv))
+                {
+                    const IntVect civ = BoxLib::coarsen(iv, rr);
+
+                    for (int n = 0; n < nv; n++)
+                        fab(iv,n) = cfab(civ,n);
+                }
+            }
+        }
+    }
+
+    if (iwrite)
+    {
+        const std::string file = BoxLib::Concatenate(rec.name + "_", step, 5);
+
+        std::ofstream os((m_dir + "/" + file).c_str(), std::ios::out|std::ios::binary);
+
+        fab.writeOn(os);
+
+        if (!os.good())
+            BoxLib::FileOpenFailed(m_dir + "/" + file);
+
+        std::ofstream ls((m_dir + "/" + rec.name + ".txt").c_str(), std::ios::out|std::ios::app);
+
+        ls.precision(17);
+
+        ls << step << ' ' << time << ' ' << file << '\n';
+    }
+}
+
+void
+InSitu::reduce (const Amr&              amr,
+                const InSituRec&        rec,
+                const PArray<MultiFab>& data,
+                const std::vector<int>& comps,
+                int                     step,
+                Real                    time) const
+{
+    const int  finest = amr.finestLevel();
+    const int  nv     = comps.size();
+    const bool hist   = (rec.type == InSituRec::Histogram);
+    const Box& dom0   = amr.Geom(0).Domain();
+    //
+    // Histograms have an underflow and an overflow bin; averages a bin per
+    // level 0 cell along dir, or just one.
+    //
+    const int nb = hist ? rec.nbins+2 : (rec.dir >= 0 ? dom0.length(rec.dir) : 1);
+
+    std::vector<Real> sums(hist ? nb : nv*nb, 0);
+    std::vector<Real> wts(nb, 0);
+
+    for (int l = 0; l <= finest; l++)
+    {
+        const Real* dx  = amr.Geom(l).CellSize();
+        const Real  vol = D_TERM(dx[0],*dx[1],*dx[2]);
+        //
+        // The ratio to level 0 and the cells covered by the next level.
+        //
+        IntVect rr = IntVect::TheUnitVector();
+        for (int k = 0; k < l; k++)
+            rr *= amr.refRatio(k);
+
+        BoxArray cfba;
+        if (l < finest)
+        {
+            cfba = data[l+1].boxArray();
+            cfba.coarsen(amr.refRatio(l));
+        }
+
+        const MultiFab& mf = data[l];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<Real> tsums(sums.size(), 0);
+            std::vector<Real> twts(wts.size(), 0);
+            BaseFab<int>      mask;
+
+            for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+            {
+                const Box&       bx  = mfi.tilebox();
+                const FArrayBox& fab = mf[mfi];
+
+                mask.resize(bx,1);
+                mask.setVal(1);
+
+                if (l < finest)
+                {
+                    const std::vector< std::pair<int,Box> >& isects = cfba.intersections(bx);
+
+                    for (int k = 0; k < isects.size(); k++)
+                        mask.setVal(0,isects[k].second,0,1);
+                }
+
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+                {
+                    if (!mask(iv)) continue;
+
+                    if (hist)
+                    {
+                        const Real v = fab(iv,comps[0]);
+
+                        int b;
+                        if (v < rec.hmin)
+                            b = 0;
+                        else if (v > rec.hmax)
+                            b = nb-1;
+                        else
+                            b = 1 + std::min(rec.nbins-1, int((v-rec.hmin)/(rec.hmax-rec.hmin)*rec.nbins));
+
+                        tsums[b] += vol;
+                    }
+                    else
+                    {
+                        const int b = (rec.dir >= 0) ? BoxLib::coarsen(iv,rr)[rec.dir] - dom0.smallEnd(rec.dir) : 0;
+
+                        twts[b] += vol;
+
+                        for (int n = 0; n < nv; n++)
+                            tsums[n*nb+b] += vol*fab(iv,comps[n]);
+                    }
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp critical(insitu_reduce)
+#endif
+            {
+                for (int k = 0; k < sums.size(); k++)
+                    sums[k] += tsums[k];
+                for (int k = 0; k < wts.size(); k++)
+                    wts[k] += twts[k];
+            }
+        }
+    }
+
+    ParallelDescriptor::ReduceRealSum(&sums[0], sums.size(), rec.cpu);
+
+    if (!hist)
+        ParallelDescriptor::ReduceRealSum(&wts[0], wts.size(), rec.cpu);
+
+    if (ParallelDescriptor::MyProc() == rec.cpu)
+    {
+        std::ofstream os((m_dir + "/" + rec.name + ".txt").c_str(), std::ios::out|std::ios::app);
+
+        os.precision(17);
+
+        os << step << ' ' << time;
+
+        if (hist)
+        {
+            for (int b = 0; b < nb; b++)
+                os << ' ' << sums[b];
+        }
+        else
+        {
+            for (int n = 0; n < nv; n++)
+                for (int b = 0; b < nb; b++)
+                    os << ' ' << (wts[b] > 0 ? sums[n*nb+b]/wts[b] : 0);
+        }
+
+        os << '\n';
+
+        if (!os.good())
+            BoxLib::FileOpenFailed(m_dir + "/" + rec.name + ".txt");
+    }
+}
@@ -271,10 +271,7 @@ SlabStatList::update (AmrLevel& amrlevel,
         {
             (*li)->m_interval += dt;
 
-            for (int i = 0; i < (*li)->tmp_mf().nComp(); i++)
-            {
-                amrlevel.derive((*li)->vars()[i],time+dt,(*li)->tmp_mf(),i);
-            }
+            amrlevel.deriveBatch((*li)->vars(),time+dt,(*li)->tmp_mf(),0);
 
             for (MFIter dmfi((*li)->mf()); dmfi.isValid(); ++dmfi)
             {
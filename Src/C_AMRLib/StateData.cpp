@@ -2,6 +2,7 @@
 #include <winstd.H>
 #include <iostream>
 #include <algorithm>
+#include <list>
 
 #include <unistd.h>
 
@@ -10,6 +11,11 @@
 #include <StateDescriptor.H>
 #include <ParallelDescriptor.H>
 #include <Utility.H>
+#include <ParmParse.H>
+
+#ifdef BL_MEM_PROFILING
+#include <MemProfiler.H>
+#endif
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -23,6 +29,159 @@ const int MFOLDDATA = 1;
 Array<std::string> StateData::fabArrayHeaderNames;
 std::map<std::string, Array<char> > *StateData::faHeaderMap;
 
+namespace
+{
+    //
+    // MultiFabs freed by StateData, most recently freed first.
+    //
+    std::list<MultiFab*> the_pool;
+
+    bool pool_initialized = false;
+    int  pool_size        = 16;
+    long pool_bytes       = 0;
+    long pool_bytes_hwm   = 0;
+    long pool_hits        = 0;
+    long pool_misses      = 0;
+
+    long
+    BytesOf (const MultiFab& mf)
+    {
+        long b = 0;
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+            b += mf[mfi].nBytes();
+        return b;
+    }
+
+    void
+    PoolFinalize ()
+    {
+        StateData::ClearPool();
+        pool_initialized = false;
+    }
+
+    void
+    PoolInitialize ()
+    {
+        if (pool_initialized) return;
+        pool_initialized = true;
+
+        ParmParse pp("statedata");
+        pp.query("pool_size", pool_size);
+
+        BoxLib::ExecOnFinalize(PoolFinalize);
+
+#ifdef BL_MEM_PROFILING
+        static bool registered = false;
+        if (!registered) {
+            registered = true;
+            MemProfiler::add("StateData Pool", std::function<MemProfiler::MemInfo()>
+                             ([] () -> MemProfiler::MemInfo {
+                                 return {pool_bytes, pool_bytes_hwm};
+                             }));
+            MemProfiler::add("StateData Pool", std::function<MemProfiler::HitsInfo()>
+                             ([] () -> MemProfiler::HitsInfo {
+                                 return {pool_hits, pool_misses};
+                             }));
+        }
+#endif
+    }
+}
+
+MultiFab*
+StateData::allocMF (const DistributionMapping* dm) const
+{
+    PoolInitialize();
+
+    const int ncomp = desc->nComp();
+    const int ngrow = desc->nExtra();
+
+    DistributionMapping dmap;
+    if (dm == 0)
+        dmap.define(grids,ParallelDescriptor::NProcs());
+    else
+        dmap = *dm;
+
+    for (std::list<MultiFab*>::iterator it = the_pool.begin(); it != the_pool.end(); ++it)
+    {
+        MultiFab* mf = *it;
+
+        if (mf->nComp() == ncomp && mf->nGrow() == ngrow &&
+            mf->boxArray() == grids && mf->DistributionMap() == dmap)
+        {
+            the_pool.erase(it);
+            pool_bytes -= BytesOf(*mf);
+            pool_hits++;
+            //
+            // Make it look like a new one.
+            //
+            for (MFIter mfi(*mf); mfi.isValid(); ++mfi)
+                (*mf)[mfi].initVal();
+
+            return mf;
+        }
+    }
+
+    pool_misses++;
+
+    return new MultiFab(grids,ncomp,ngrow,dmap,Fab_allocate);
+}
+
+void
+StateData::freeMF (MultiFab* mf)
+{
+    if (mf == 0) return;
+
+    PoolInitialize();
+
+    if (pool_size <= 0)
+    {
+        delete mf;
+        return;
+    }
+
+    the_pool.push_front(mf);
+    pool_bytes += BytesOf(*mf);
+    pool_bytes_hwm = std::max(pool_bytes, pool_bytes_hwm);
+
+    while (the_pool.size() > static_cast<size_t>(pool_size))
+    {
+        pool_bytes -= BytesOf(*the_pool.back());
+        delete the_pool.back();
+        the_pool.pop_back();
+    }
+}
+
+void
+StateData::ClearPool ()
+{
+    for (std::list<MultiFab*>::iterator it = the_pool.begin(); it != the_pool.end(); ++it)
+        delete *it;
+    the_pool.clear();
+    pool_bytes = 0;
+}
+
+void
+StateData::TrimPool (const Array<BoxArray>& keep)
+{
+    for (std::list<MultiFab*>::iterator it = the_pool.begin(); it != the_pool.end(); )
+    {
+        bool found = false;
+        for (int i = 0; i < keep.size() && !found; ++i)
+            found = (*it)->boxArray().CellEqual(keep[i]);
+
+        if (found)
+        {
+            ++it;
+        }
+        else
+        {
+            pool_bytes -= BytesOf(**it);
+            delete *it;
+            it = the_pool.erase(it);
+        }
+    }
+}
+
 
 StateData::StateData () 
 {
@@ -98,9 +257,7 @@ StateData::define (const Box&             p_domain,
         old_time.start = time-dt;
         old_time.stop  = time;
     }
-    int ncomp = desc->nComp();
-
-    new_data = new MultiFab(grids,ncomp,desc->nExtra(),Fab_allocate);
+    new_data = allocMF();
 
     old_data = 0;
 }
@@ -139,9 +296,7 @@ StateData::define (const Box&             p_domain,
         old_time.start = time-dt;
         old_time.stop  = time;
     }
-    int ncomp = desc->nComp();
-
-    new_data = new MultiFab(grids,ncomp,desc->nExtra(),dm,Fab_allocate);
+    new_data = allocMF(&dm);
 
     old_data = 0;
 }
@@ -276,8 +431,8 @@ StateData::restartDoit (std::istream& is, const std::string& chkfile)
     int nsets;
     is >> nsets;
 
-    old_data = (nsets == 2) ? new MultiFab(grids,desc->nComp(),desc->nExtra(),Fab_allocate) : 0;
-    new_data =                new MultiFab(grids,desc->nComp(),desc->nExtra(),Fab_allocate);
+    old_data = (nsets == 2) ? allocMF() : 0;
+    new_data =                allocMF();
     //
     // If no data is written then we just allocate the MF instead of reading it in. 
     // This assumes that the application will do something with it.
@@ -344,15 +499,15 @@ StateData::restart (const StateDescriptor& d,
     new_time.start = rhs.new_time.start;
     new_time.stop  = rhs.new_time.stop;
     old_data = 0;
-    new_data = new MultiFab(grids,desc->nComp(),desc->nExtra(),Fab_allocate);
+    new_data = allocMF();
     new_data->setVal(0.);
 }
 
 StateData::~StateData()
 {
    desc = 0;
-   delete new_data;
-   delete old_data;
+   freeMF(new_data);
+   freeMF(old_data);
 }
 
 void
@@ -360,7 +515,7 @@ StateData::allocOldData ()
 {
     if (old_data == 0)
     {
-        old_data = new MultiFab(grids,desc->nComp(),desc->nExtra());
+        old_data = allocMF();
     }
 }
 
@@ -455,14 +610,14 @@ void
 StateData::replaceOldData (MultiFab* mf)
 {
     std::swap(old_data, mf);
-    delete mf;
+    freeMF(mf);
 }
 
 void
 StateData::replaceNewData (MultiFab* mf)
 {
     std::swap(new_data, mf);
-    delete mf;
+    freeMF(mf);
 }
 
 void
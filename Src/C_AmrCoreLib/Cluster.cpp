@@ -1,10 +1,27 @@
 
 #include <winstd.H>
 #include <algorithm>
+#include <vector>
 #include <Cluster.H>
 #include <BoxDomain.H>
+#include <BLProfiler.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 enum CutStatus { HoleCut=0, SteepCut, BisectCut, InvalidCut };
+//
+// Clusters with at least this many points get their histograms and
+// bounding boxes computed by all threads (outside of a parallel region).
+// ClusterList::chop() chops them one at a time and hands smaller ones
+// to OpenMP tasks.
+//
+static const long ParallelChopSize = 200000;
+//
+// Smaller clusters are chopped by the task that made them.
+//
+static const long ChopTaskSize = 1000;
 
 Cluster::Cluster ()
     :
@@ -134,10 +151,26 @@ Cluster::minBox ()
     else
     {
         IntVect lo = m_ar[0], hi = lo;
-        for (int i = 1; i < m_len; i++)
+#ifdef _OPENMP
+#pragma omp parallel if (m_len >= ParallelChopSize && !omp_in_parallel())
+#endif
         {
-            lo.min(m_ar[i]);
-            hi.max(m_ar[i]);
+            IntVect tlo = lo, thi = hi;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for (long i = 1; i < m_len; i++)
+            {
+                tlo.min(m_ar[i]);
+                thi.max(m_ar[i]);
+            }
+#ifdef _OPENMP
+#pragma omp critical(cluster_minbox)
+#endif
+            {
+                lo.min(tlo);
+                hi.max(thi);
+            }
         }
         m_bx = Box(lo,hi);
     }
@@ -267,13 +300,33 @@ Cluster::chop ()
         for (int i = 0; i < len[n]; i++)
             hist[n][i] = 0;
     }
-    for (int n = 0; n < m_len; n++)
+#ifdef _OPENMP
+#pragma omp parallel if (m_len >= ParallelChopSize && !omp_in_parallel())
+#endif
     {
-        const int* p = m_ar[n].getVect();
-        D_TERM( hist[0][p[0]-lo[0]]++;,
-                hist[1][p[1]-lo[1]]++;,
-                hist[2][p[2]-lo[2]]++; )
-     }
+        //
+        // Each thread counts into its own histograms; the sums are exact.
+        //
+        std::vector<int> thist[BL_SPACEDIM];
+        for (int n = 0; n < BL_SPACEDIM; n++)
+            thist[n].resize(len[n],0);
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (long n = 0; n < m_len; n++)
+        {
+            const int* p = m_ar[n].getVect();
+            D_TERM( thist[0][p[0]-lo[0]]++;,
+                    thist[1][p[1]-lo[1]]++;,
+                    thist[2][p[2]-lo[2]]++; )
+        }
+#ifdef _OPENMP
+#pragma omp critical(cluster_hist)
+#endif
+        for (int n = 0; n < BL_SPACEDIM; n++)
+            for (int i = 0; i < len[n]; i++)
+                hist[n][i] += thist[n][i];
+    }
     //
     // Find cutpoint and cutstatus in each index direction.
     //
@@ -409,20 +462,110 @@ ClusterList::boxList (BoxList& blst) const
     }
 }
 
-void
-ClusterList::chop (Real eff)
+namespace
 {
-    for (std::list<Cluster*>::iterator cli = lst.begin(); cli != lst.end(); )
+    //
+    // A cluster and, in order, the clusters chopped off of it.
+    //
+    struct ChopTree
     {
-        if ((*cli)->eff() < eff)
+        explicit ChopTree (Cluster* c_) : c(c_) {}
+
+        ~ChopTree ()
         {
-            lst.push_back((*cli)->chop());
+            for (int i = 0, N = kids.size(); i < N; i++)
+                delete kids[i];
         }
-        else
+
+        Cluster*               c;
+        std::vector<ChopTree*> kids;
+    };
+    //
+    // Chops t->c until it is efficient enough, then its pieces likewise,
+    // each in its own task if it is big enough.
+    //
+    void
+    ChopSmall (ChopTree* t, Real eff)
+    {
+        const int first = t->kids.size();
+
+        while (t->c->eff() < eff)
+            t->kids.push_back(new ChopTree(t->c->chop()));
+
+        for (int i = first, N = t->kids.size(); i < N; i++)
         {
-            ++cli;
+            ChopTree* kid = t->kids[i];
+#ifdef _OPENMP
+#pragma omp task if (kid->c->numTag() >= ChopTaskSize)
+#endif
+            ChopSmall(kid, eff);
         }
     }
+    //
+    // Chops the big clusters one at a time with threaded histograms and
+    // collects the rest for ChopSmall().
+    //
+    void
+    ChopLarge (ChopTree* t, Real eff, std::vector<ChopTree*>& small)
+    {
+        while (t->c->numTag() >= ParallelChopSize && t->c->eff() < eff)
+            t->kids.push_back(new ChopTree(t->c->chop()));
+
+        if (t->c->eff() < eff)
+            small.push_back(t);
+
+        for (int i = 0, N = t->kids.size(); i < N; i++)
+            ChopLarge(t->kids[i], eff, small);
+    }
+}
+
+void
+ClusterList::chop (Real eff)
+{
+    BL_PROFILE("ClusterList::chop()");
+
+    std::vector<ChopTree*> roots;
+
+    for (std::list<Cluster*>::iterator cli = lst.begin(); cli != lst.end(); ++cli)
+        roots.push_back(new ChopTree(*cli));
+
+    std::vector<ChopTree*> small;
+
+    for (int i = 0, N = roots.size(); i < N; i++)
+        ChopLarge(roots[i], eff, small);
+
+    const int nsmall = small.size();
+
+#ifdef _OPENMP
+#pragma omp parallel if (nsmall > 1 || (nsmall == 1 && small[0]->c->numTag() >= ChopTaskSize))
+#pragma omp single
+#endif
+    for (int i = 0; i < nsmall; i++)
+    {
+        ChopTree* t = small[i];
+#ifdef _OPENMP
+#pragma omp task
+#endif
+        ChopSmall(t, eff);
+    }
+    //
+    // Each chop leaves the cluster in place and appends the piece cut off
+    // to the end of the list, so the list is the breadth-first order of
+    // the trees.  Rebuilding it that way gives the same grids, in the same
+    // order, as chopping one cluster at a time.
+    //
+    lst.clear();
+
+    std::vector<ChopTree*> queue(roots);
+
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        lst.push_back(queue[i]->c);
+        queue.insert(queue.end(), queue[i]->kids.begin(), queue[i]->kids.end());
+    }
+
+    for (int i = 0, N = roots.size(); i < N; i++)
+        delete roots[i];
 }
 
 void
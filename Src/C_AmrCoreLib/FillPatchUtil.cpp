@@ -1,11 +1,208 @@
 
 #include <FillPatchUtil.H>
 #include <cmath>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+FillPatchPlan::FillPatchPlan ()
+{
+    m_crse_patch[0] = m_crse_patch[1] = 0;
+}
+
+FillPatchPlan::~FillPatchPlan ()
+{
+    clear();
+}
+
+void
+FillPatchPlan::clear ()
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        delete m_crse_patch[i];
+        m_crse_patch[i] = 0;
+    }
+}
+
+MultiFab&
+FillPatchPlan::crsePatch (int                        i,
+                          const BoxArray&            ba,
+                          const DistributionMapping& dm,
+                          int                        ncomp)
+{
+    BL_ASSERT(i == 0 || i == 1);
+
+    MultiFab*& mf = m_crse_patch[i];
+
+    if (mf == 0 || mf->nComp() != ncomp || mf->boxArray() != ba || mf->DistributionMap() != dm)
+    {
+        delete mf;
+        mf = new MultiFab(ba, ncomp, 0, dm);
+    }
+
+    return *mf;
+}
+
+namespace
+{
+    //
+    // FillPatchSingleLevel for a coarse patch, i.e. a destination that does
+    // not share the source BoxArray.  Data at two times are interpolated in
+    // time into tmf, which has the source layout, and then copied, so there
+    // is a single copy.  Only the source cells the patch needs are
+    // interpolated, not the whole level.
+    //
+    void FillCrsePatch (MultiFab& mf, MultiFab* tmf, Real time,
+			const PArray<MultiFab>& smf, const std::vector<Real>& stime,
+			int scomp, int ncomp,
+			const Geometry& geom, PhysBCFunctBase& physbcf)
+    {
+	BL_PROFILE("FillCrsePatch");
+
+	BL_ASSERT(smf.size() == stime.size());
+	BL_ASSERT(smf.size() != 0);
+
+	if (smf.size() == 1)
+	{
+	    mf.copy(smf[0], scomp, 0, ncomp, 0, 0, geom.periodicity());
+	}
+	else if (smf.size() == 2)
+	{
+	    BL_ASSERT(tmf != 0);
+	    BL_ASSERT(smf[0].boxArray() == smf[1].boxArray());
+	    BL_ASSERT(tmf->boxArray() == smf[0].boxArray());
+
+	    const BoxArray&             pba     = mf.boxArray();
+	    const std::vector<IntVect>& pshifts = geom.periodicity().shiftIntVect();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+	    {
+		std::vector< std::pair<int,Box> > isects;
+
+		for (MFIter mfi(*tmf,true); mfi.isValid(); ++mfi)
+		{
+		    const Box& tbx = mfi.tilebox();
+
+		    for (int i = 0; i < pshifts.size(); ++i)
+		    {
+			pba.intersections(tbx+pshifts[i], isects);
+
+			for (int k = 0; k < isects.size(); ++k)
+			{
+			    const Box& bx = isects[k].second - pshifts[i];
+
+			    (*tmf)[mfi].linInterp(smf[0][mfi],
+						  scomp,
+						  smf[1][mfi],
+						  scomp,
+						  stime[0],
+						  stime[1],
+						  time,
+						  bx,
+						  0,
+						  ncomp);
+			}
+		    }
+		}
+	    }
+
+	    mf.copy(*tmf, 0, 0, ncomp, 0, 0, geom.periodicity());
+	}
+	else {
+	    BoxLib::Abort("FillCoarsePatch: high-order interpolation in time not implemented yet");
+	}
+
+	physbcf.FillBoundary(mf, 0, ncomp, time);
+    }
+    //
+    // A piece of a fine region to be interpolated from coarse patch ci
+    // into destination fab fi (both global indices).
+    //
+    struct InterpTile
+    {
+	InterpTile (int ci_, int fi_, const Box& bx_) : ci(ci_), fi(fi_), bx(bx_) {}
+	int ci;
+	int fi;
+	Box bx;
+    };
+    //
+    // Splits the fine region dbx into refinements of coarse boxes that are
+    // roughly the size of the MFIter tiles but at least two coarse cells
+    // wide, which is what Interpolater::tileable() requires.
+    //
+    void AddInterpTiles (std::vector<InterpTile>& tiles, int ci, int fi,
+			 const Box& dbx, const IntVect& ratio)
+    {
+	std::vector<Box> cboxes(1, BoxLib::coarsen(dbx,ratio));
+
+	for (int d = 0; d < BL_SPACEDIM; ++d)
+	{
+	    const int T = std::max(2, FabArrayBase::mfiter_tile_size[d]/ratio[d]);
+
+	    std::vector<Box> pieces;
+
+	    for (int i = 0, N = cboxes.size(); i < N; ++i)
+	    {
+		Box cbx = cboxes[i];
+		const int n  = cbx.length(d);
+		const int np = std::max(1, n/T);
+		const int lo = cbx.smallEnd(d);
+
+		for (int p = np-1; p > 0; --p) {
+		    pieces.push_back(cbx.chop(d, lo + (p*n)/np));
+		}
+		pieces.push_back(cbx);
+	    }
+
+	    cboxes.swap(pieces);
+	}
+
+	for (int i = 0, N = cboxes.size(); i < N; ++i) {
+	    tiles.push_back(InterpTile(ci, fi, BoxLib::refine(cboxes[i],ratio) & dbx));
+	}
+    }
+
+    void InterpTiles (const std::vector<InterpTile>& tiles,
+		      const MultiFab& crse, MultiFab& mf,
+		      int scomp, int dcomp, int ncomp,
+		      const Geometry& cgeom, const Geometry& fgeom,
+		      const Box& fdomain, const IntVect& ratio,
+		      Interpolater* mapper, const Array<BCRec>& bcs)
+    {
+	const int N = tiles.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (int i = 0; i < N; ++i)
+	{
+	    const InterpTile& t = tiles[i];
+
+	    Array<BCRec> bcr(ncomp);
+	    BoxLib::setBC(t.bx,fdomain,scomp,0,ncomp,bcs,bcr);
+
+	    int idummy1=0, idummy2=0;
+
+	    mapper->interp(crse[t.ci],
+			   0,
+			   mf[t.fi],
+			   dcomp,
+			   ncomp,
+			   t.bx,
+			   ratio,
+			   cgeom,
+			   fgeom,
+			   bcr,
+			   idummy1, idummy2);
+	}
+    }
+}
+
 namespace BoxLib
 {
     bool ProperlyNested (const IntVect& ratio, int blocking_factor, int ngrow,
@@ -114,13 +311,31 @@ namespace BoxLib
 			     const Geometry& cgeom, const Geometry& fgeom, 
 			     PhysBCFunctBase& cbc, PhysBCFunctBase& fbc,
 			     const IntVect& ratio, 
-			     Interpolater* mapper, const Array<BCRec>& bcs)
+			     Interpolater* mapper, const Array<BCRec>& bcs,
+			     FillPatchPlan* plan)
     {
 	BL_PROFILE("FillPatchTwoLevels");
 
+	FillCoarsePatch(mf, time, cmf, ct, fmf[0], scomp, dcomp, ncomp,
+			cgeom, fgeom, cbc, ratio, mapper, bcs, plan);
+
+	FillPatchSingleLevel(mf, time, fmf, ft, scomp, dcomp, ncomp, fgeom, fbc);
+    }
+
+    void FillCoarsePatch (MultiFab& mf, Real time,
+			  const PArray<MultiFab>& cmf, const std::vector<Real>& ct,
+			  const MultiFab& fmf,
+			  int scomp, int dcomp, int ncomp,
+			  const Geometry& cgeom, const Geometry& fgeom, 
+			  PhysBCFunctBase& cbc, const IntVect& ratio, 
+			  Interpolater* mapper, const Array<BCRec>& bcs,
+			  FillPatchPlan* plan)
+    {
+	BL_PROFILE("FillCoarsePatch");
+
 	int ngrow = mf.nGrow();
 	    
-	if (ngrow > 0 || mf.getBDKey() != fmf[0].getBDKey()) 
+	if (ngrow > 0 || mf.getBDKey() != fmf.getBDKey()) 
 	{
 	    const InterpolaterBoxCoarsener& coarsener = mapper->BoxCoarsener(ratio);
 	    
@@ -133,16 +348,57 @@ namespace BoxLib
 		}
 	    }
 	    
-	    const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(fmf[0], mf, fdomain_g, ngrow, coarsener);
+	    const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(fmf, mf, fdomain_g, ngrow, coarsener);
 
 	    if ( ! fpc.ba_crse_patch.empty())
 	    {
-		MultiFab mf_crse_patch(fpc.ba_crse_patch, ncomp, 0, fpc.dm_crse_patch);
-		
-		FillPatchSingleLevel(mf_crse_patch, time, cmf, ct, scomp, 0, ncomp, cgeom, cbc);
+		PArray<MultiFab> raii(PArrayManage);
+		MultiFab* crse_patch = 0;
+		MultiFab* crse_time  = 0;
+
+		if (plan) {
+		    crse_patch = &plan->crsePatch(0, fpc.ba_crse_patch, fpc.dm_crse_patch, ncomp);
+		} else {
+		    crse_patch = raii.push_back(new MultiFab(fpc.ba_crse_patch, ncomp, 0,
+							     fpc.dm_crse_patch));
+		}
+
+		if (ct.size() == 2)
+		{
+		    if (plan) {
+			crse_time = &plan->crsePatch(1, cmf[0].boxArray(), cmf[0].DistributionMap(), ncomp);
+		    } else {
+			crse_time = raii.push_back(new MultiFab(cmf[0].boxArray(), ncomp, 0,
+								cmf[0].DistributionMap()));
+		    }
+		}
+
+		MultiFab& mf_crse_patch = *crse_patch;
+
+		FillCrsePatch(mf_crse_patch, crse_time, time, cmf, ct, scomp, ncomp, cgeom, cbc);
 		
 		int idummy1=0, idummy2=0;
 		bool cc = fpc.ba_crse_patch.ixType().cellCentered();
+
+		if (cc && mapper->tileable())
+		{
+		    //
+		    // Split the patches so that a few large ones still keep
+		    // all the threads busy.
+		    //
+		    std::vector<InterpTile> tiles;
+
+		    for (MFIter mfi(mf_crse_patch); mfi.isValid(); ++mfi)
+		    {
+			int li = mfi.LocalIndex();
+			AddInterpTiles(tiles, mfi.index(), fpc.dst_idxs[li], fpc.dst_boxes[li], ratio);
+		    }
+
+		    InterpTiles(tiles, mf_crse_patch, mf, scomp, dcomp, ncomp,
+				cgeom, fgeom, fdomain, ratio, mapper, bcs);
+		}
+		else
+		{
 #ifdef _OPENMP
 #pragma omp parallel if (cc)
 #endif
@@ -167,10 +423,9 @@ namespace BoxLib
 				   bcr,
 				   idummy1, idummy2);
 		}
+		}
 	    }
 	}
-
-	FillPatchSingleLevel(mf, time, fmf, ft, scomp, dcomp, ncomp, fgeom, fbc);
     }
 
     void InterpFromCoarseLevel (MultiFab& mf, Real time, const MultiFab& cmf, 
@@ -217,6 +472,21 @@ namespace BoxLib
 
 	int idummy1=0, idummy2=0;
 
+	if (typ.cellCentered() && mapper->tileable())
+	{
+	    std::vector<InterpTile> tiles;
+
+	    for (MFIter mfi(mf_crse_patch); mfi.isValid(); ++mfi)
+	    {
+		const Box& dbx = mf[mfi].box() & fdomain_g;
+		AddInterpTiles(tiles, mfi.index(), mfi.index(), dbx, ratio);
+	    }
+
+	    InterpTiles(tiles, mf_crse_patch, mf, scomp, dcomp, ncomp,
+			cgeom, fgeom, fdomain, ratio, mapper, bcs);
+	}
+	else
+	{
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -240,6 +510,7 @@ namespace BoxLib
 			   bcr,
 			   idummy1, idummy2);	    
 	}
+	}
 
 	fbc.FillBoundary(mf, dcomp, ncomp, time);
     }
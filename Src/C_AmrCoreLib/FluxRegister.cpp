@@ -14,6 +14,9 @@ FluxRegister::FluxRegister ()
     fine_level = ncomp = -1;
     ratio = IntVect::TheUnitVector();
     ratio.scale(-1);
+
+    for (int i = 0; i < 2*BL_SPACEDIM; i++)
+        reflux_flux[i] = 0;
 }
 
 FluxRegister::FluxRegister (const BoxArray& fine_boxes, 
@@ -21,6 +24,9 @@ FluxRegister::FluxRegister (const BoxArray& fine_boxes,
                             int             fine_lev,
                             int             nvar)
 {
+    for (int i = 0; i < 2*BL_SPACEDIM; i++)
+        reflux_flux[i] = 0;
+
     define(fine_boxes,ref_ratio,fine_lev,nvar);
 }
 
@@ -30,9 +36,37 @@ FluxRegister::FluxRegister (const BoxArray&            fine_boxes,
                             int                        nvar,
                             const DistributionMapping& dm)
 {
+    for (int i = 0; i < 2*BL_SPACEDIM; i++)
+        reflux_flux[i] = 0;
+
     define(fine_boxes,ref_ratio,fine_lev,nvar,dm);
 }
 
+FluxRegister::FluxRegister (const FluxRegister& rhs)
+    :
+    BndryRegister(rhs),
+    ratio(rhs.ratio),
+    fine_level(rhs.fine_level),
+    ncomp(rhs.ncomp)
+{
+    for (int i = 0; i < 2*BL_SPACEDIM; i++)
+        reflux_flux[i] = 0;
+}
+
+FluxRegister&
+FluxRegister::operator= (const FluxRegister& rhs)
+{
+    if (this != &rhs)
+    {
+        BndryRegister::operator=(rhs);
+        ratio      = rhs.ratio;
+        fine_level = rhs.fine_level;
+        ncomp      = rhs.ncomp;
+        clearRefluxCache();
+    }
+    return *this;
+}
+
 const IntVect&
 FluxRegister::refRatio () const
 {
@@ -72,6 +106,8 @@ FluxRegister::define (const BoxArray& fine_boxes,
     BL_ASSERT(fine_boxes.isDisjoint());
     BL_ASSERT(grids.size() == 0);
 
+    clearRefluxCache();
+
     ratio      = ref_ratio;
     fine_level = fine_lev;
     ncomp      = nvar;
@@ -103,6 +139,8 @@ FluxRegister::define (const BoxArray&            fine_boxes,
     BL_ASSERT(fine_boxes.isDisjoint());
     BL_ASSERT(grids.size() == 0);
 
+    clearRefluxCache();
+
     ratio      = ref_ratio;
     fine_level = fine_lev;
     ncomp      = nvar;
@@ -124,7 +162,96 @@ FluxRegister::define (const BoxArray&            fine_boxes,
     }
 }
 
-FluxRegister::~FluxRegister () {}
+FluxRegister::~FluxRegister ()
+{
+    clearRefluxCache();
+}
+
+void
+FluxRegister::clearRefluxCache ()
+{
+    for (int i = 0; i < 2*BL_SPACEDIM; i++)
+    {
+        delete reflux_flux[i];
+        reflux_flux[i] = 0;
+        reflux_touched[i].clear();
+    }
+    reflux_ba     = BoxArray();
+    reflux_dm     = DistributionMapping();
+    reflux_period = Periodicity();
+}
+
+void
+FluxRegister::buildRefluxCache (const MultiFab& mf,
+                                const Geometry& geom)
+{
+    if (reflux_flux[0] != 0                  &&
+        reflux_ba     == mf.boxArray()        &&
+        reflux_dm     == mf.DistributionMap() &&
+        reflux_period == geom.periodicity())
+    {
+        return;
+    }
+
+    BL_PROFILE("FluxRegister::buildRefluxCache()");
+
+    clearRefluxCache();
+
+    const BoxArray&            ba     = mf.boxArray();
+    const std::vector<IntVect> pshift = geom.periodicity().shiftIntVect();
+
+    std::vector< std::pair<int,Box> > isects;
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+	const Orientation& face = fi();
+	int idir = face.coordDir();
+
+	const BoxArray& rba = bndry[face].boxArray();
+	//
+	// The fluxes are only needed on the faces of each grid that the
+	// register (or one of its periodic images) touches.  Grids that
+	// touch none of it get a single face and are skipped.
+	//
+	BoxArray    fba(ba.size());
+	Array<int>& touched = reflux_touched[face];
+
+	touched.resize(ba.size(),0);
+
+	for (int i = 0, N = ba.size(); i < N; ++i)
+	{
+	    const Box& nbx = BoxLib::surroundingNodes(ba[i],idir);
+
+	    Box fbx;
+
+	    for (int k = 0, NS = pshift.size(); k < NS; ++k)
+	    {
+		rba.intersections(Box(nbx).shift(pshift[k]),isects);
+
+		for (int m = 0, NI = isects.size(); m < NI; ++m)
+		{
+		    Box bx = isects[m].second;
+		    bx.shift(-pshift[k]);
+
+		    if (touched[i])
+			fbx.minBox(bx);
+		    else
+			fbx = bx;
+
+		    touched[i] = 1;
+		}
+	    }
+
+	    fba.set(i, touched[i] ? fbx : Box(nbx.smallEnd(),nbx.smallEnd(),nbx.ixType()));
+	}
+
+	reflux_flux[face] = new MultiFab(fba, ncomp, 0, mf.DistributionMap());
+    }
+
+    reflux_ba     = ba;
+    reflux_dm     = mf.DistributionMap();
+    reflux_period = geom.periodicity();
+}
 
 Real
 FluxRegister::SumReg (int comp) const
@@ -160,56 +287,26 @@ FluxRegister::CrseInit (const MultiFab& mflx,
                         Real            mult,
                         FrOp            op)
 {
-    BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
-    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
+    BL_ASSERT(area.boxArray() == mflx.boxArray());
 
-    const Orientation face_lo(dir,Orientation::low);
-    const Orientation face_hi(dir,Orientation::high);
- 
-    MultiFab mf(mflx.boxArray(),numcomp,0);
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif    
-    for (MFIter mfi(mflx,true); mfi.isValid(); ++mfi)
-    {
-	const Box& bx = mfi.tilebox();
-	
-        mf[mfi].copy(mflx[mfi],bx,srccomp,bx,0,numcomp);
-
-        mf[mfi].mult(mult,bx,0,numcomp);
-
-        for (int i = 0; i < numcomp; i++)
-            mf[mfi].mult(area[mfi],bx,bx,0,i,1);
-    }
-
-    for (int pass = 0; pass < 2; pass++)
-    {
-        const Orientation face = ((pass == 0) ? face_lo : face_hi);
-
-        if (op == FluxRegister::COPY)
-        {
-            bndry[face].copyFrom(mf,0,0,destcomp,numcomp);
-        }
-        else
-        {
-            FabSet fs(bndry[face].boxArray(),numcomp);
-
-            fs.setVal(0);
-
-            fs.copyFrom(mf,0,0,0,numcomp);
+    CrseInit(mflx,&area,dir,srccomp,destcomp,numcomp,mult,op);
+}
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-            for (FabSetIter mfi(fs); mfi.isValid(); ++mfi)
-                bndry[face][mfi].plus(fs[mfi],0,destcomp,numcomp);
-        }
-    }
+void
+FluxRegister::CrseInit (const MultiFab& mflx,
+                        int             dir,
+                        int             srccomp,
+                        int             destcomp,
+                        int             numcomp,
+                        Real            mult,
+                        FrOp            op)
+{
+    CrseInit(mflx,0,dir,srccomp,destcomp,numcomp,mult,op);
 }
 
 void
 FluxRegister::CrseInit (const MultiFab& mflx,
+                        const MultiFab* area,
                         int             dir,
                         int             srccomp,
                         int             destcomp,
@@ -217,14 +314,81 @@ FluxRegister::CrseInit (const MultiFab& mflx,
                         Real            mult,
                         FrOp            op)
 {
+    BL_PROFILE("FluxRegister::CrseInit()");
+
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
 
-    MultiFab area(mflx.boxArray(), 1, mflx.nGrow());
+    const BoxArray& fba = mflx.boxArray();
+    //
+    // The area, if any, goes into the last component of the scratch space.
+    //
+    const int acomp = numcomp;
+    const int nscr  = (area == 0) ? numcomp : numcomp+1;
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const Orientation face(dir, (pass == 0) ? Orientation::low : Orientation::high);
+
+        FabSet& reg = bndry[face];
+        //
+        // Only the register faces are copied to, using the CPC cached by
+        // FabArray::copy(), and then scaled in place.  The register is
+        // about the size of the boundary of the fine level, not the size
+        // of the coarse level.
+        //
+        FabSet fs;
+
+        fs.define(reg.boxArray(),nscr,reg.DistributionMap());
+
+        fs.setVal(0);
 
-    area.setVal(1, 0, 1, area.nGrow());
+        fs.copyFrom(mflx,0,srccomp,0,numcomp);
 
-    CrseInit(mflx,area,dir,srccomp,destcomp,numcomp,mult,op);
+        if (area != 0)
+            fs.copyFrom(*area,0,0,acomp,1);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector< std::pair<int,Box> > isects;
+
+            for (FabSetIter fsi(fs); fsi.isValid(); ++fsi)
+            {
+                FArrayBox& sfab = fs[fsi];
+                FArrayBox& rfab = reg[fsi];
+
+                sfab.mult(mult,0,numcomp);
+
+                if (area != 0)
+                {
+                    const Box& bx = sfab.box();
+
+                    for (int i = 0; i < numcomp; i++)
+                        sfab.mult(sfab,bx,bx,acomp,i,1);
+                }
+
+                if (op == FluxRegister::COPY)
+                {
+                    //
+                    // Leave the faces not covered by mflx alone.
+                    //
+                    fba.intersections(sfab.box(),isects);
+
+                    for (int k = 0, N = isects.size(); k < N; k++)
+                    {
+                        const Box& bx = isects[k].second;
+                        rfab.copy(sfab,bx,0,bx,destcomp,numcomp);
+                    }
+                }
+                else
+                {
+                    rfab.plus(sfab,0,destcomp,numcomp);
+                }
+            }
+        }
+    }
 }
 
 void
@@ -364,61 +528,93 @@ FluxRegister::Reflux (MultiFab&       mf,
 		      int             dcomp,
 		      int             ncomp,
 		      const Geometry& geom)
+{
+    Reflux(mf,&volume,0,scale,scomp,dcomp,ncomp,geom);
+}
+
+void 
+FluxRegister::Reflux (MultiFab&       mf,
+		      Real            scale,
+		      int             scomp,
+		      int             dcomp,
+		      int             ncomp,
+		      const Geometry& geom)
+{
+    const Real* dx = geom.CellSize();
+
+    Reflux(mf,0,D_TERM(dx[0],*dx[1],*dx[2]),scale,scomp,dcomp,ncomp,geom);
+}
+
+void 
+FluxRegister::Reflux (MultiFab&       mf,
+		      const MultiFab* volume,
+		      Real            vol,
+		      Real            scale,
+		      int             scomp,
+		      int             dcomp,
+		      int             ncomp,
+		      const Geometry& geom)
 {
     BL_PROFILE("FluxRegister::Reflux()");
 
+    buildRefluxCache(mf, geom);
+
     for (OrientationIter fi; fi; ++fi)
     {
 	const Orientation& face = fi();
 	int idir = face.coordDir();
 	int islo = face.isLow();
 
-	MultiFab flux(mf.boxArray(), ncomp, 0, Fab_allocate, IntVect::TheDimensionVector(idir));
-	flux.setVal(0.0);
+	const Array<int>& touched = reflux_touched[face];
+
+	MultiFab& flux = *reflux_flux[face];
+
+	flux.setVal(0.0, 0, ncomp);
 
 	bndry[face].copyTo(flux, 0, scomp, 0, ncomp, geom.periodicity());
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-	for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
 	{
-	    const Box& bx = mfi.tilebox();
+	    FArrayBox vtmp;
 
-	    FArrayBox& sfab = mf[mfi];
-	    const Box& sbox = sfab.box();
+	    for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+	    {
+		if (!touched[mfi.index()]) continue;
+		//
+		// The cells next to the register faces.
+		//
+		const FArrayBox& ffab = flux[mfi];
+		const Box&       fbox = ffab.box();
 
-	    const FArrayBox& ffab = flux[mfi];
-	    const Box& fbox = ffab.box();
-	    
-	    const FArrayBox& vfab = volume[mfi];
-	    const Box& vbox = vfab.box();
-
-	    FORT_FRREFLUX(bx.loVect(), bx.hiVect(),
-			  sfab.dataPtr(dcomp), sbox.loVect(), sbox.hiVect(),
-			  ffab.dataPtr(     ), fbox.loVect(), fbox.hiVect(),
-			  vfab.dataPtr(     ), vfab.loVect(), vbox.hiVect(),
-			  &ncomp, &scale, &idir, &islo);
-			  
-	}
-    }
-}
+		Box bx(fbox.smallEnd(), fbox.bigEnd());
+		if (islo) bx.shift(idir,-1);
+		bx &= mfi.tilebox();
 
-void 
-FluxRegister::Reflux (MultiFab&       mf,
-		      Real            scale,
-		      int             scomp,
-		      int             dcomp,
-		      int             ncomp,
-		      const Geometry& geom)
-{
-    const Real* dx = geom.CellSize();
-    
-    MultiFab volume(mf.boxArray(), 1, mf.nGrow());
-    
-    volume.setVal(D_TERM(dx[0],*dx[1],*dx[2]), 0, 1, mf.nGrow());
+		if (!bx.ok()) continue;
+
+		FArrayBox& sfab = mf[mfi];
+		const Box& sbox = sfab.box();
+
+		const FArrayBox* vfab = (volume != 0) ? &(*volume)[mfi] : &vtmp;
+
+		if (volume == 0)
+		{
+		    vtmp.resize(bx,1);
+		    vtmp.setVal(vol);
+		}
 
-    Reflux(mf,volume,scale,scomp,dcomp,ncomp,geom);
+		const Box& vbox = vfab->box();
+
+		FORT_FRREFLUX(bx.loVect(), bx.hiVect(),
+			      sfab.dataPtr(dcomp), sbox.loVect(), sbox.hiVect(),
+			      ffab.dataPtr(     ), fbox.loVect(), fbox.hiVect(),
+			      vfab->dataPtr(     ), vbox.loVect(), vbox.hiVect(),
+			      &ncomp, &scale, &idir, &islo);
+	    }
+	}
+    }
 }
 
 void
@@ -228,6 +228,111 @@ GetBCArray (const Array<BCRec>& bcr)
     return bc;
 }
 
+#if (BL_SPACEDIM > 1)
+//
+// Per-thread scratch space for the slopes of LinCCInterp.  It is kept
+// between calls, so filling many small patches does not allocate.
+//
+static FArrayBox* lincc_slopes = 0;
+#ifdef _OPENMP
+#pragma omp threadprivate(lincc_slopes)
+#endif
+
+//
+// Linear conservative interpolation shared by CellConservativeLinear
+// and CellConservativeProtected.
+//
+static
+void
+LinCCInterp (const FArrayBox& crse,
+             int              crse_comp,
+             FArrayBox&       fine,
+             int              fine_comp,
+             int              ncomp,
+             const Box&       fine_region,
+             const IntVect&   ratio,
+             const Geometry&  crse_geom,
+             const Geometry&  fine_geom,
+             Array<BCRec>&    bcr,
+             int              lin_limit,
+             int              actual_comp,
+             int              actual_state)
+{
+    BL_ASSERT(bcr.size() >= ncomp);
+    //
+    // Make box which is intersection of fine_region and domain of fine.
+    //
+    Box target_fine_region = fine_region & fine.box();
+    //
+    // Slopes are needed only on coarsening of target_fine_region.
+    //
+    Box cslope_bx = BoxLib::coarsen(target_fine_region,ratio);
+    //
+    // crse_bx is coarsening of target_fine_region, grown by 1.
+    //
+    Box crse_bx = BoxLib::grow(cslope_bx,1);
+    //
+    // Make a refinement of cslope_bx
+    //
+    Box fine_version_of_cslope_bx = BoxLib::refine(cslope_bx,ratio);
+    //
+    // Get coarse and fine edge-centered volume coordinates.
+    //
+    Array<Real> fvc[BL_SPACEDIM];
+    Array<Real> cvc[BL_SPACEDIM];
+    for (int dir = 0; dir < BL_SPACEDIM; dir++)
+    {
+        fine_geom.GetEdgeVolCoord(fvc[dir],fine_version_of_cslope_bx,dir);
+        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+    }
+    //
+    // The slopes and limiters of one component at a time.
+    //
+    if (lincc_slopes == 0)
+        lincc_slopes = new FArrayBox;
+
+    lincc_slopes->resize(cslope_bx,3*BL_SPACEDIM+3);
+
+    Real* fdat        = fine.dataPtr(fine_comp);
+    const Real* cdat  = crse.dataPtr(crse_comp);
+    const int* flo    = fine.loVect();
+    const int* fhi    = fine.hiVect();
+    const int* clo    = crse.loVect();
+    const int* chi    = crse.hiVect();
+    const int* fblo   = target_fine_region.loVect();
+    const int* fbhi   = target_fine_region.hiVect();
+    const int* csbhi  = cslope_bx.hiVect();
+    const int* csblo  = cslope_bx.loVect();
+    const int* cvcblo = crse_bx.loVect();
+    const int* fvcblo = fine_version_of_cslope_bx.loVect();
+
+    int cvcbhi[BL_SPACEDIM];
+    int fvcbhi[BL_SPACEDIM];
+
+    for (int dir = 0; dir < BL_SPACEDIM; dir++)
+    {
+        cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
+        fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
+    }
+
+    Array<int> bc     = GetBCArray(bcr);
+    const int* ratioV = ratio.getVect();
+
+    FORT_LINCCINTERP2 (fdat,ARLIM(flo),ARLIM(fhi),
+                       fblo, fbhi,
+                       ARLIM(fvcblo), ARLIM(fvcbhi),
+                       cdat,ARLIM(clo),ARLIM(chi),
+                       ARLIM(cvcblo), ARLIM(cvcbhi),
+                       lincc_slopes->dataPtr(), ARLIM(csblo), ARLIM(csbhi),
+                       csblo, csbhi,
+                       &ncomp,D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
+                       bc.dataPtr(), &lin_limit,
+                       D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
+                       D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
+                       &actual_comp,&actual_state);
+}
+#endif /*(BL_SPACEDIM > 1)*/
+
 CellConservativeLinear::CellConservativeLinear (bool do_linear_limiting_)
 {
     do_linear_limiting = do_linear_limiting_;
@@ -254,6 +359,16 @@ CellConservativeLinear::CoarseBox (const Box& fine,
     return crse;
 }
 
+bool
+CellConservativeLinear::tileable () const
+{
+    //
+    // The slopes and limiters only look at the coarse neighbors of
+    // each coarse cell, as long as the BCs are set for each piece.
+    //
+    return BL_SPACEDIM > 1;
+}
+
 void
 CellConservativeLinear::interp (const FArrayBox& crse,
                                 int              crse_comp,
@@ -269,6 +384,12 @@ CellConservativeLinear::interp (const FArrayBox& crse,
                                 int              actual_state)
 {
     BL_PROFILE("CellConservativeLinear::interp()");
+
+#if (BL_SPACEDIM > 1)
+    LinCCInterp(crse,crse_comp,fine,fine_comp,ncomp,fine_region,ratio,
+                crse_geom,fine_geom,bcr,(do_linear_limiting ? 1 : 0),
+                actual_comp,actual_state);
+#else
     BL_ASSERT(bcr.size() >= ncomp);
 
     //
@@ -383,7 +504,7 @@ CellConservativeLinear::interp (const FArrayBox& crse,
                       &actual_comp,&actual_state);
 
     D_TERM(delete [] voffx;, delete [] voffy;, delete [] voffz;);
-
+#endif /*(BL_SPACEDIM > 1)*/
 }
 
 CellQuadratic::CellQuadratic (bool limit)
@@ -528,6 +649,12 @@ PCInterp::CoarseBox (const Box&     fine,
     return BoxLib::coarsen(fine,ratio);
 }
 
+bool
+PCInterp::tileable () const
+{
+    return true;
+}
+
 void
 PCInterp::interp (const FArrayBox& crse,
                   int              crse_comp,
@@ -618,120 +745,10 @@ CellConservativeProtected::interp (const FArrayBox& crse,
                                    int              actual_state)
 {
     BL_PROFILE("CellConservativeProtected::interp()");
-    BL_ASSERT(bcr.size() >= ncomp);
-    //
-    // Make box which is intersection of fine_region and domain of fine.
-    //
-    Box target_fine_region = fine_region & fine.box();
-    //
-    // crse_bx is coarsening of target_fine_region, grown by 1.
-    //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
-    //
-    // Slopes are needed only on coarsening of target_fine_region.
-    //
-    Box cslope_bx(crse_bx);
-    cslope_bx.grow(-1);
-    //
-    // Make a refinement of cslope_bx
-    //
-    Box fine_version_of_cslope_bx = BoxLib::refine(cslope_bx,ratio);
-    //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    Array<Real> fvc[BL_SPACEDIM];
-    Array<Real> cvc[BL_SPACEDIM];
-    int dir;
-    for (dir = 0; dir < BL_SPACEDIM; dir++)
-    {
-        fine_geom.GetEdgeVolCoord(fvc[dir],fine_version_of_cslope_bx,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
-    //
-    // alloc tmp space for slope calc.
-    //
-    // In ucc_slopes and lcc_slopes , there is a slight abuse of 
-    // the number of compenents argument
-    // --> there is a slope for each component in each coordinate 
-    //     direction
-    //
-    FArrayBox ucc_slopes(cslope_bx,ncomp*BL_SPACEDIM);
-    FArrayBox lcc_slopes(cslope_bx,ncomp*BL_SPACEDIM);
-    FArrayBox slope_factors(cslope_bx,BL_SPACEDIM);
-
-    FArrayBox  cmax(cslope_bx,ncomp);
-    FArrayBox  cmin(cslope_bx,ncomp);
-    FArrayBox alpha(cslope_bx,ncomp);
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-    Real* ucc_xsldat = ucc_slopes.dataPtr(0);
-    Real* lcc_xsldat = lcc_slopes.dataPtr(0);
-    Real* xslfac_dat = slope_factors.dataPtr(0);
-#if (BL_SPACEDIM>=2)
-    Real* ucc_ysldat = ucc_slopes.dataPtr(ncomp);
-    Real* lcc_ysldat = lcc_slopes.dataPtr(ncomp);
-    Real* yslfac_dat = slope_factors.dataPtr(1);
-#endif
-#if (BL_SPACEDIM==3)
-    Real* ucc_zsldat = ucc_slopes.dataPtr(2*ncomp);
-    Real* lcc_zsldat = lcc_slopes.dataPtr(2*ncomp);
-    Real* zslfac_dat = slope_factors.dataPtr(2);
-#endif
-    
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* csbhi  = cslope_bx.hiVect();
-    const int* csblo  = cslope_bx.loVect();
-    int lin_limit     = 1;
-    const int* cvcblo = crse_bx.loVect();
-    const int* fvcblo = fine_version_of_cslope_bx.loVect();
-
-    int cvcbhi[BL_SPACEDIM];
-    int fvcbhi[BL_SPACEDIM];
-
-    for (dir=0; dir<BL_SPACEDIM; dir++)
-    {
-        cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
-        fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
-    }
-
-    D_TERM(Real* voffx = new Real[fvc[0].size()];,
-           Real* voffy = new Real[fvc[1].size()];,
-           Real* voffz = new Real[fvc[2].size()];);
-
-    Array<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-    int slope_flag    = 1;
 
 #if (BL_SPACEDIM > 1)
-
-    FORT_LINCCINTERP (fdat,ARLIM(flo),ARLIM(fhi),
-                      fblo, fbhi,
-                      ARLIM(fvcblo), ARLIM(fvcbhi),
-                      cdat,ARLIM(clo),ARLIM(chi),
-                      ARLIM(cvcblo), ARLIM(cvcbhi),
-                      ucc_xsldat, lcc_xsldat, xslfac_dat,
-                      ucc_ysldat, lcc_ysldat, yslfac_dat,
-#if (BL_SPACEDIM==3)
-                      ucc_zsldat, lcc_zsldat, zslfac_dat,
-#endif
-                      ARLIM(csblo), ARLIM(csbhi),
-                      csblo, csbhi,
-                      &ncomp,D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                      bc.dataPtr(), &slope_flag, &lin_limit,
-                      D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
-                      D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
-                      D_DECL(voffx,voffy,voffz),
-                      alpha.dataPtr(),cmax.dataPtr(),cmin.dataPtr(),
-                      &actual_comp,&actual_state);
-
-    D_TERM(delete [] voffx;, delete [] voffy;, delete [] voffz;);
-
+    LinCCInterp(crse,crse_comp,fine,fine_comp,ncomp,fine_region,ratio,
+                crse_geom,fine_geom,bcr,1,actual_comp,actual_state);
 #endif /*(BL_SPACEDIM > 1)*/
 }
 
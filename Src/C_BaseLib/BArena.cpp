@@ -1,14 +1,29 @@
+#include <cstdlib>
+#include <new>
 
 #include <BArena.H>
 
 void*
 BArena::alloc (std::size_t _sz)
 {
+#if defined(WIN32)
     return ::operator new(_sz);
+#else
+    void* pt = 0;
+
+    if (posix_memalign(&pt, BArena::fab_align, _sz == 0 ? 1 : _sz) != 0)
+        throw std::bad_alloc();
+
+    return pt;
+#endif
 }
 
 void
 BArena::free (void* pt)
 {
+#if defined(WIN32)
     ::operator delete(pt);
+#else
+    std::free(pt);
+#endif
 }
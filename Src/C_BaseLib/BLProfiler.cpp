@@ -450,6 +450,19 @@ void BLProfiler::RegionStop(const std::string &rname) {
 }
 
 
+bool BLProfiler::GetExclusiveTime(const std::string &fname, long &ncalls, Real &t) {
+  std::map<std::string, ProfStats>::const_iterator it = mProfStats.find(fname);
+  if(it == mProfStats.end()) {
+    ncalls = 0;
+    t = 0.0;
+    return false;
+  }
+  ncalls = it->second.nCalls;
+  t = it->second.totalTime;
+  return true;
+}
+
+
 void BLProfiler::Finalize() {
   if( ! bInitialized) {
     return;
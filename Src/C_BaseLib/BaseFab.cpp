@@ -11,6 +11,7 @@
 #if !(defined(BL_NO_FORT) || defined(WIN32))
 #include <BaseFab_f.H>
 #endif
+#include <FabSimd.H>
 
 #ifdef BL_MEM_PROFILING
 #include <MemProfiler.H>
@@ -163,6 +164,39 @@ BoxLib::The_Arena ()
 }
 
 #if !(defined(BL_NO_FORT) || defined(WIN32))
+namespace
+{
+    //
+    // The pencils along direction 0 of bx, a subbox of a FAB on fbx.  The
+    // primitives below walk them by pointer strides and apply a FabSimd
+    // kernel to each: at(p,j,k) is pencil (j,k) of the component p starts.
+    //
+    struct Pencils
+    {
+        Pencils (const Box& fbx, const Box& bx)
+            :
+            len(bx.length(0)), nj(1), nk(1), jstride(0), kstride(0)
+        {
+#if (BL_SPACEDIM > 1)
+            nj      = bx.length(1);
+            jstride = fbx.length(0);
+#endif
+#if (BL_SPACEDIM == 3)
+            nk      = bx.length(2);
+            kstride = jstride * fbx.length(1);
+#endif
+            first = D_TERM(  bx.smallEnd(0) - fbx.smallEnd(0),
+                           + (bx.smallEnd(1) - fbx.smallEnd(1)) * jstride,
+                           + (bx.smallEnd(2) - fbx.smallEnd(2)) * kstride);
+        }
+
+        template <class T>
+        T* at (T* p, long j, long k) const { return p + first + j*jstride + k*kstride; }
+
+        long first, len, nj, nk, jstride, kstride;
+    };
+}
+
 template<>
 void
 BaseFab<Real>::performCopy (const BaseFab<Real>& src,
@@ -179,10 +213,17 @@ BaseFab<Real>::performCopy (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
-    fort_fab_copy(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		  BL_TO_FORTRAN_N_3D(*this,destcomp),
-		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		  &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Copy(pd.at(d,j,k), ps.at(s,j,k), pd.len);
+    }
 }
 
 template <>
@@ -197,10 +238,21 @@ BaseFab<Real>::copyToMem (const Box& srcbox,
 
     if (srcbox.ok())
     {
-	fort_fab_copytomem(ARLIM_3D(srcbox.loVect()), ARLIM_3D(srcbox.hiVect()),
-			   dst,
-			   BL_TO_FORTRAN_N_3D(*this,srccomp),
-			   &numcomp);
+        const Pencils ps(domain, srcbox);
+
+        for (int n = 0; n < numcomp; n++)
+        {
+            const Real* s = dataPtr(srccomp+n);
+
+            for (long k = 0; k < ps.nk; k++)
+            {
+                for (long j = 0; j < ps.nj; j++)
+                {
+                    FabSimd::Copy(dst, ps.at(s,j,k), ps.len);
+                    dst += ps.len;
+                }
+            }
+        }
     }
 }
 
@@ -216,9 +268,21 @@ BaseFab<Real>::copyFromMem (const Box&  dstbox,
 
     if (dstbox.ok()) 
     {
-	fort_fab_copyfrommem(ARLIM_3D(dstbox.loVect()), ARLIM_3D(dstbox.hiVect()),
-			     BL_TO_FORTRAN_N_3D(*this,dstcomp), &numcomp,
-			     src);
+        const Pencils pd(domain, dstbox);
+
+        for (int n = 0; n < numcomp; n++)
+        {
+            Real* d = dataPtr(dstcomp+n);
+
+            for (long k = 0; k < pd.nk; k++)
+            {
+                for (long j = 0; j < pd.nj; j++)
+                {
+                    FabSimd::Copy(pd.at(d,j,k), src, pd.len);
+                    src += pd.len;
+                }
+            }
+        }
     }
 }
 
@@ -232,9 +296,16 @@ BaseFab<Real>::performSetVal (Real       val,
     BL_ASSERT(domain.contains(bx));
     BL_ASSERT(comp >= 0 && comp + ncomp <= nvar);
 
-    fort_fab_setval(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
-		    BL_TO_FORTRAN_N_3D(*this,comp), &ncomp,
-		    &val);
+    const Pencils pd(domain, bx);
+
+    for (int n = 0; n < ncomp; n++)
+    {
+        Real* d = dataPtr(comp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::SetVal(pd.at(d,j,k), val, pd.len);
+    }
 }
 
 template<>
@@ -263,13 +334,27 @@ BaseFab<Real>::norm (const Box& bx,
     BL_ASSERT(domain.contains(bx));
     BL_ASSERT(comp >= 0 && comp + ncomp <= nvar);
 
-    Real nrm;
+    Real nrm = 0;
 
     if (p == 0 || p == 1)
     {
-	nrm = fort_fab_norm(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
-			    BL_TO_FORTRAN_N_3D(*this,comp), &ncomp,
-			    &p);
+        const Pencils px(domain, bx);
+
+        for (int n = 0; n < ncomp; n++)
+        {
+            const Real* x = dataPtr(comp+n);
+
+            for (long k = 0; k < px.nk; k++)
+            {
+                for (long j = 0; j < px.nj; j++)
+                {
+                    if (p == 0)
+                        nrm = std::max(nrm, FabSimd::AbsMax(px.at(x,j,k), px.len));
+                    else
+                        nrm += FabSimd::AbsSum(px.at(x,j,k), px.len);
+                }
+            }
+        }
     }
     else
     {
@@ -288,8 +373,20 @@ BaseFab<Real>::sum (const Box& bx,
     BL_ASSERT(domain.contains(bx));
     BL_ASSERT(comp >= 0 && comp + ncomp <= nvar);
 
-    return fort_fab_sum(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
-			BL_TO_FORTRAN_N_3D(*this,comp), &ncomp);
+    const Pencils px(domain, bx);
+
+    Real sm = 0;
+
+    for (int n = 0; n < ncomp; n++)
+    {
+        const Real* x = dataPtr(comp+n);
+
+        for (long k = 0; k < px.nk; k++)
+            for (long j = 0; j < px.nj; j++)
+                sm += FabSimd::Sum(px.at(x,j,k), px.len);
+    }
+
+    return sm;
 }
 
 template<>
@@ -308,10 +405,17 @@ BaseFab<Real>::plus (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
-    fort_fab_plus(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		  BL_TO_FORTRAN_N_3D(*this,destcomp),
-		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		  &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Plus(pd.at(d,j,k), ps.at(s,j,k), pd.len);
+    }
 
     return *this;
 }
@@ -332,10 +436,17 @@ BaseFab<Real>::mult (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
-    fort_fab_mult(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		  BL_TO_FORTRAN_N_3D(*this,destcomp),
-		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		  &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Mult(pd.at(d,j,k), ps.at(s,j,k), pd.len);
+    }
     return *this;
 }
 
@@ -356,11 +467,17 @@ BaseFab<Real>::saxpy (Real a, const BaseFab<Real>& src,
     BL_ASSERT( srccomp >= 0 &&  srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <=     nComp());
 
-    fort_fab_saxpy(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		   BL_TO_FORTRAN_N_3D(*this,destcomp),
-		   &a,
-		   BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		   &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Saxpy(pd.at(d,j,k), a, ps.at(s,j,k), pd.len);
+    }
     return *this;
 }
 
@@ -381,11 +498,17 @@ BaseFab<Real>::xpay (Real a, const BaseFab<Real>& src,
     BL_ASSERT( srccomp >= 0 &&  srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <=     nComp());
 
-    fort_fab_xpay(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		  BL_TO_FORTRAN_N_3D(*this,destcomp),
-		  &a,
-		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		  &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Xpay(pd.at(d,j,k), a, ps.at(s,j,k), pd.len);
+    }
     return *this;
 }
 
@@ -429,10 +552,17 @@ BaseFab<Real>::minus (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
-    fort_fab_minus(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
-		   BL_TO_FORTRAN_N_3D(*this,destcomp),
-		   BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
-		   &numcomp);
+    const Pencils pd(domain, destbox), ps(src.box(), srcbox);
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        Real*       d = dataPtr(destcomp+n);
+        const Real* s = src.dataPtr(srccomp+n);
+
+        for (long k = 0; k < pd.nk; k++)
+            for (long j = 0; j < pd.nj; j++)
+                FabSimd::Minus(pd.at(d,j,k), ps.at(s,j,k), pd.len);
+    }
     return *this;
 }
 
@@ -529,10 +659,63 @@ BaseFab<Real>::dot (const Box& xbx, int xcomp,
     BL_ASSERT(xcomp >= 0 && xcomp+numcomp <=   nComp());
     BL_ASSERT(ycomp >= 0 && ycomp+numcomp <= y.nComp());
 
-    return fort_fab_dot(ARLIM_3D(xbx.loVect()), ARLIM_3D(xbx.hiVect()),
-			BL_TO_FORTRAN_N_3D(*this,xcomp),
-			BL_TO_FORTRAN_N_3D(y,ycomp), ARLIM_3D(ybx.loVect()),
-			&numcomp);
+    const Pencils px(domain, xbx), py(y.box(), ybx);
+
+    Real dp = 0;
+
+    for (int n = 0; n < numcomp; n++)
+    {
+        const Real* x  = dataPtr(xcomp+n);
+        const Real* yp = y.dataPtr(ycomp+n);
+
+        for (long k = 0; k < px.nk; k++)
+            for (long j = 0; j < px.nj; j++)
+                dp += FabSimd::Dot(px.at(x,j,k), py.at(yp,j,k), px.len);
+    }
+
+    return dp;
+}
+
+template <>
+Real
+BaseFab<Real>::min (const Box& subbox,
+                    int        comp) const
+{
+    BL_ASSERT(subbox.ok());
+    BL_ASSERT(domain.contains(subbox));
+    BL_ASSERT(comp >= 0 && comp < nvar);
+
+    const Pencils px(domain, subbox);
+    const Real*   x = dataPtr(comp);
+
+    Real mn = (*this)(subbox.smallEnd(),comp);
+
+    for (long k = 0; k < px.nk; k++)
+        for (long j = 0; j < px.nj; j++)
+            mn = std::min(mn, FabSimd::Min(px.at(x,j,k), px.len));
+
+    return mn;
+}
+
+template <>
+Real
+BaseFab<Real>::max (const Box& subbox,
+                    int        comp) const
+{
+    BL_ASSERT(subbox.ok());
+    BL_ASSERT(domain.contains(subbox));
+    BL_ASSERT(comp >= 0 && comp < nvar);
+
+    const Pencils px(domain, subbox);
+    const Real*   x = dataPtr(comp);
+
+    Real mx = (*this)(subbox.smallEnd(),comp);
+
+    for (long k = 0; k < px.nk; k++)
+        for (long j = 0; j < px.nj; j++)
+            mx = std::max(mx, FabSimd::Max(px.at(x,j,k), px.len));
+
+    return mx;
 }
 
 #endif
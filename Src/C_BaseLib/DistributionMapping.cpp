@@ -1851,7 +1851,8 @@ PFCMultiLevelToken::Compare::operator () (const PFCMultiLevelToken& lhs,
 Array<Array<int> >
 DistributionMapping::MultiLevelMapPFC (const Array<IntVect>  &refRatio,
                                        const Array<BoxArray> &allBoxes,
-				       int maxgrid)
+				       int maxgrid,
+                                       const Array<Array<long> > &boxWork)
 {
     BL_PROFILE("DistributionMapping::MultiLevelMapPFC()");
 
@@ -1863,9 +1864,16 @@ DistributionMapping::MultiLevelMapPFC (const Array<IntVect>  &refRatio,
     int nLevels(allBoxes.size());
     int finestLevel(nLevels - 1);
     int nBoxes(0);
+    BL_ASSERT(boxWork.empty() || boxWork.size() == nLevels);
     for(int level(0); level < nLevels; ++level) {
       nBoxes += allBoxes[level].size();
-      totalCells += allBoxes[level].numPts();
+      if(boxWork.empty()) {
+        totalCells += allBoxes[level].numPts();
+      } else {
+        for(int i(0); i < boxWork[level].size(); ++i) {
+          totalCells += boxWork[level][i];
+        }
+      }
     }
 
     std::vector< std::vector<int> > vec(nProcs);
@@ -1879,7 +1887,8 @@ DistributionMapping::MultiLevelMapPFC (const Array<IntVect>  &refRatio,
 	Box box(allBoxes[level][i]);
 	Box fine(BoxLib::refine(box, cRR));
         tokens.push_back(PFCMultiLevelToken(level, idxAll, i,
-	                 box.smallEnd(), fine.smallEnd(), box.numPts()));
+	                 box.smallEnd(), fine.smallEnd(),
+                         boxWork.empty() ? box.numPts() : boxWork[level][i]));
       }
       if(level > 0) {
         cRR *= refRatio[level - 1];
@@ -2087,7 +2096,8 @@ DistributionMapping::MultiLevelMapRandom (const Array<IntVect>  &refRatio,
 Array<Array<int> >
 DistributionMapping::MultiLevelMapKnapSack (const Array<IntVect>  &refRatio,
                                             const Array<BoxArray> &allBoxes,
-					    int maxgrid)
+					    int maxgrid,
+                                            const Array<Array<long> > &boxWork)
 {
     BL_PROFILE("DistributionMapping::MultiLevelMapKnapSack()");
 
@@ -2101,7 +2111,7 @@ DistributionMapping::MultiLevelMapKnapSack (const Array<IntVect>  &refRatio,
     for(int n(0); n < allBoxes.size(); ++n) {
       const BoxArray &aba = allBoxes[n];
       for(int b(0); b < aba.size(); ++b) {
-        weights.push_back(aba[b].numPts());
+        weights.push_back(boxWork.empty() ? aba[b].numPts() : boxWork[n][b]);
       }
     }
 
@@ -2137,7 +2147,8 @@ DistributionMapping::MultiLevelMapKnapSack (const Array<IntVect>  &refRatio,
 
 void
 DistributionMapping::PFCMultiLevelMap (const Array<IntVect>  &refRatio,
-                                       const Array<BoxArray> &allBoxes)
+                                       const Array<BoxArray> &allBoxes,
+                                       const Array<Array<long> > &boxWork)
 {
     BL_PROFILE("DistributionMapping::PFCMultiLevelMap()");
 
@@ -2150,9 +2161,16 @@ DistributionMapping::PFCMultiLevelMap (const Array<IntVect>  &refRatio,
     int nLevels(allBoxes.size());
     int finestLevel(nLevels - 1);
     int nBoxes(0);
+    BL_ASSERT(boxWork.empty() || boxWork.size() == nLevels);
     for(int level(0); level < nLevels; ++level) {
       nBoxes += allBoxes[level].size();
-      totalCells += allBoxes[level].numPts();
+      if(boxWork.empty()) {
+        totalCells += allBoxes[level].numPts();
+      } else {
+        for(int i(0); i < boxWork[level].size(); ++i) {
+          totalCells += boxWork[level][i];
+        }
+      }
     }
 
     std::vector< std::vector<int> > vec(nprocs);
@@ -2166,7 +2184,8 @@ DistributionMapping::PFCMultiLevelMap (const Array<IntVect>  &refRatio,
 	Box box(allBoxes[level][i]);
 	Box fine(BoxLib::refine(box, cRR));
         tokens.push_back(PFCMultiLevelToken(level, idxAll, i,
-	                 box.smallEnd(), fine.smallEnd(), box.numPts()));
+	                 box.smallEnd(), fine.smallEnd(),
+                         boxWork.empty() ? box.numPts() : boxWork[level][i]));
       }
       if(level > 0) {
         cRR *= refRatio[level - 1];
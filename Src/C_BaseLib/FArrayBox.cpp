@@ -19,6 +19,7 @@
 #include <Looping.H>
 #include <Utility.H>
 #include <MemPool.H>
+#include <FabSimd.H>
 
 bool FArrayBox::initialized = false;
 
@@ -538,6 +539,8 @@ FArrayBox::Initialize ()
     pp.query("do_initval", do_initval);
     pp.query("init_snan", init_snan);
 
+    FabSimd::Initialize();
+
     BoxLib::ExecOnFinalize(FArrayBox::Finalize);
 }
 
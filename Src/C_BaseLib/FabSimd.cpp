@@ -0,0 +1,129 @@
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <FabSimd.H>
+#include <BoxLib.H>
+#include <ParmParse.H>
+#include <ParallelDescriptor.H>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(BL_NO_SIMD_DISPATCH)
+#define BL_SIMD_DISPATCH
+#endif
+
+namespace FabSimd_Generic
+{
+#define BL_SIMD_TARGET
+#include <FabSimd_K.H>
+#undef BL_SIMD_TARGET
+}
+
+#ifdef BL_SIMD_DISPATCH
+namespace FabSimd_AVX2
+{
+#define BL_SIMD_TARGET __attribute__((target("avx2")))
+#include <FabSimd_K.H>
+#undef BL_SIMD_TARGET
+}
+
+namespace FabSimd_AVX512
+{
+#define BL_SIMD_TARGET __attribute__((target("avx512f")))
+#include <FabSimd_K.H>
+#undef BL_SIMD_TARGET
+}
+#endif
+
+namespace
+{
+    FabSimd::ISA selected = FabSimd::Generic;
+}
+
+const FabSimd::Kernels* FabSimd::kernels = &FabSimd_Generic::table;
+
+bool
+FabSimd::Supported (ISA isa)
+{
+    if (isa == Generic) return true;
+
+#ifdef BL_SIMD_DISPATCH
+    __builtin_cpu_init();
+
+    if (isa == AVX2)   return __builtin_cpu_supports("avx2");
+    if (isa == AVX512) return __builtin_cpu_supports("avx512f");
+#endif
+
+    return false;
+}
+
+bool
+FabSimd::Select (ISA isa)
+{
+    if (!Supported(isa)) return false;
+
+    switch (isa)
+    {
+#ifdef BL_SIMD_DISPATCH
+    case AVX2:   kernels = &FabSimd_AVX2::table;   break;
+    case AVX512: kernels = &FabSimd_AVX512::table; break;
+#endif
+    default:     kernels = &FabSimd_Generic::table;
+    }
+
+    selected = isa;
+
+    return true;
+}
+
+FabSimd::ISA
+FabSimd::Selected ()
+{
+    return selected;
+}
+
+const char*
+FabSimd::Name (ISA isa)
+{
+    switch (isa)
+    {
+    case AVX2:   return "avx2";
+    case AVX512: return "avx512";
+    default:     return "generic";
+    }
+}
+
+void
+FabSimd::Initialize ()
+{
+    ParmParse pp("fab");
+
+    std::string simd("auto");
+    pp.query("simd", simd);
+
+    if (simd == "auto")
+    {
+        if (!Select(AVX512) && !Select(AVX2))
+            Select(Generic);
+    }
+    else
+    {
+        ISA isa = Generic;
+
+        if (simd == "avx2")
+            isa = AVX2;
+        else if (simd == "avx512")
+            isa = AVX512;
+        else if (simd != "generic")
+            BoxLib::Abort("FabSimd::Initialize(): fab.simd must be auto, generic, avx2 or avx512");
+
+        if (!Select(isa))
+        {
+            if (ParallelDescriptor::IOProcessor())
+                std::cout << "FabSimd: " << simd << " isn't supported, using generic kernels\n";
+
+            Select(Generic);
+        }
+    }
+}
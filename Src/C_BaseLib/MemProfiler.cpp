@@ -42,6 +42,19 @@ MemProfiler::add (const std::string& name, std::function<NBuildsInfo()>&& f)
     mprofiler.the_funcs_builds.push_back(std::forward<std::function<NBuildsInfo()> >(f));
 }
 
+void 
+MemProfiler::add (const std::string& name, std::function<HitsInfo()>&& f)
+{
+    MemProfiler& mprofiler = getInstance();
+    auto it = std::find(mprofiler.the_names_hits.begin(), mprofiler.the_names_hits.end(), name);
+    if (it != mprofiler.the_names_hits.end()) {
+        std::string s = "MemProfiler::add (HitsInfo) failed because " + name + " already existed";
+        BoxLib::Abort(s.c_str());
+    }
+    mprofiler.the_names_hits.push_back(name);
+    mprofiler.the_funcs_hits.push_back(std::forward<std::function<HitsInfo()> >(f));
+}
+
 MemProfiler& 
 MemProfiler::getInstance ()
 {
@@ -86,6 +99,16 @@ MemProfiler::report_ (const std::string& prefix, const std::string& memory_log_n
     std::vector<int>  num_builds_max = num_builds_min;
     std::vector<int>  hwm_builds_max = hwm_builds_min;
 
+    std::vector<long> hits_min;
+    std::vector<long> misses_min;
+    for (auto&& f: the_funcs_hits) {
+	const HitsInfo& hinfo = f();
+	hits_min.push_back(hinfo.hits);
+	misses_min.push_back(hinfo.misses);
+    }
+    std::vector<long> hits_max   = hits_min;
+    std::vector<long> misses_max = misses_min;
+
 #ifdef __linux
     const int N = 9;
 #else
@@ -201,6 +224,13 @@ MemProfiler::report_ (const std::string& prefix, const std::string& memory_log_n
     ParallelDescriptor::ReduceIntMin (&hwm_builds_min[0], hwm_builds_min.size(), IOProc);
     ParallelDescriptor::ReduceIntMax (&hwm_builds_max[0], hwm_builds_max.size(), IOProc);
 
+    if (!the_funcs_hits.empty()) {
+	ParallelDescriptor::ReduceLongMin(&hits_min[0], hits_min.size(), IOProc);
+	ParallelDescriptor::ReduceLongMax(&hits_max[0], hits_max.size(), IOProc);
+	ParallelDescriptor::ReduceLongMin(&misses_min[0], misses_min.size(), IOProc);
+	ParallelDescriptor::ReduceLongMax(&misses_max[0], misses_max.size(), IOProc);
+    }
+
     if (ParallelDescriptor::IOProcessor()) {
 
 	std::ofstream memlog(memory_log_name.c_str(), 
@@ -213,6 +243,8 @@ MemProfiler::report_ (const std::string& prefix, const std::string& memory_log_n
 		width_name = std::max(width_name, int(x.size()));
 	    for (auto& x: the_names_builds)
 		width_name = std::max(width_name, int(x.size()));
+	    for (auto& x: the_names_hits)
+		width_name = std::max(width_name, int(x.size()));
 	}
 	const int width_bytes = 18;
 
@@ -280,6 +312,28 @@ MemProfiler::report_ (const std::string& prefix, const std::string& memory_log_n
 	    }
 	}
 
+	// Reuse of pooled memory
+	if (!the_names_hits.empty()) {
+	    memlog << "\n";
+	    memlog << ident;
+	    memlog << "| " << std::setw(width_name) << std::left << "Name" << " | "
+		   << std::setw(width_bytes) << std::right << "Hits #       " << " | "
+		   << std::setw(width_bytes) << "Misses #       " << " |\n";
+	    std::setw(0);
+	    
+	    memlog << ident;
+	    memlog << "|-" << dash_name << "-+-" << dash_bytes << "-+-" << dash_bytes << "-|\n";
+	    
+	    for (int i = 0; i < the_names_hits.size(); ++i) {
+		if (hits_max[i] > 0 || misses_max[i] > 0) {
+		    memlog << ident;
+		    memlog << "| " << std::setw(width_name) << std::left << the_names_hits[i] << " | ";
+		    memlog << Counts{hits_min[i],hits_max[i]} << " | ";
+		    memlog << Counts{misses_min[i],misses_max[i]} << " |\n";
+		}
+	    }
+	}
+
 #ifdef __linux
 	if (ierr_proc_status == 0) {
 	    memlog << "\n";
@@ -353,3 +407,12 @@ operator<< (std::ostream& os, const MemProfiler::Builds& builds)
     os << std::setw(0);
     return os;
 }
+
+std::ostream& 
+operator<< (std::ostream& os, const MemProfiler::Counts& counts)
+{
+    os << std::setw(6) << std::right << counts.mn << " ... "
+       << std::setw(7) << std::left  << counts.mx; 
+    os << std::setw(0);
+    return os;
+}
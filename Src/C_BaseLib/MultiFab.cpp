@@ -1450,3 +1450,452 @@ MultiFab::AddProcsToComp (int ioProcNumSCS, int ioProcNumAll,
   FabArray<FArrayBox>::AddProcsToComp(ioProcNumSCS, ioProcNumAll, scsMyId, scsComm);
 }
 
+
+MultiFabReduction::MultiFabReduction ()
+    :
+    reduced(false)
+{}
+
+void
+MultiFabReduction::clear ()
+{
+    items.clear();
+    results.clear();
+    reduced = false;
+}
+
+int
+MultiFabReduction::addItem (Kind kind, const MultiFab& x, int xcomp,
+                            const MultiFab* y, int ycomp, int ncomp, int nghost)
+{
+    BL_ASSERT(x.nComp() >= xcomp + ncomp);
+    BL_ASSERT(x.nGrow() >= nghost);
+    BL_ASSERT(items.empty() || x.boxArray() == items[0].x->boxArray());
+    BL_ASSERT(items.empty() || x.DistributionMap() == items[0].x->DistributionMap());
+
+    Item item;
+
+    item.kind   = kind;
+    item.x      = &x;
+    item.y      = y;
+    item.xcomp  = xcomp;
+    item.ycomp  = ycomp;
+    item.ncomp  = ncomp;
+    item.nghost = nghost;
+
+    items.push_back(item);
+
+    reduced = false;
+
+    return items.size() - 1;
+}
+
+int
+MultiFabReduction::addDot (const MultiFab& x, int xcomp,
+                           const MultiFab& y, int ycomp,
+                           int num_comp, int nghost)
+{
+    BL_ASSERT(x.boxArray() == y.boxArray());
+    BL_ASSERT(x.DistributionMap() == y.DistributionMap());
+    BL_ASSERT(y.nComp() >= ycomp + num_comp);
+    BL_ASSERT(y.nGrow() >= nghost);
+
+    return addItem(Dot, x, xcomp, &y, ycomp, num_comp, nghost);
+}
+
+int
+MultiFabReduction::addNorm0 (const MultiFab& x, int comp, int num_comp, int nghost)
+{
+    return addItem(Norm0, x, comp, 0, 0, num_comp, nghost);
+}
+
+int
+MultiFabReduction::addNorm1 (const MultiFab& x, int comp, int num_comp, int nghost)
+{
+    return addItem(Norm1, x, comp, 0, 0, num_comp, nghost);
+}
+
+int
+MultiFabReduction::addNorm2 (const MultiFab& x, int comp, int num_comp)
+{
+    return addItem(Norm2, x, comp, 0, 0, num_comp, 0);
+}
+
+ParallelDescriptor::Color
+MultiFabReduction::computeLocal (Array<Real>& sums, Array<Real>& maxs) const
+{
+    BL_PROFILE("MultiFabReduction::computeLocal()");
+
+    const int n = items.size();
+    //
+    // Each item goes either into the sums or into the maxes.
+    //
+    sums.resize(n, 0);
+    maxs.resize(n, 0);
+
+    if (n == 0) return ParallelDescriptor::DefaultColor();
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+#else
+    int nthreads = 1;
+#endif
+    PArray< Array<Real> > priv_sums(nthreads, PArrayManage);
+    PArray< Array<Real> > priv_maxs(nthreads, PArrayManage);
+    for (int i=0; i<nthreads; i++) {
+	priv_sums.set(i, new Array<Real>(n, 0.0));
+	priv_maxs.set(i, new Array<Real>(n, 0.0));
+    }
+
+    const MultiFab& mf0 = *items[0].x;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+	int tid = omp_get_thread_num();
+#else
+	int tid = 0;
+#endif
+        Array<Real>& psum = priv_sums[tid];
+        Array<Real>& pmax = priv_maxs[tid];
+
+	for (MFIter mfi(mf0,true); mfi.isValid(); ++mfi)
+	{
+            for (int i = 0; i < n; i++)
+            {
+                const Item&      it  = items[i];
+                const Box&       bx  = mfi.growntilebox(it.nghost);
+                const FArrayBox& xfab = (*it.x)[mfi];
+
+                switch (it.kind)
+                {
+                case Dot:
+                    psum[i] += xfab.dot(bx,it.xcomp,(*it.y)[mfi],bx,it.ycomp,it.ncomp);
+                    break;
+                case Norm0:
+                    pmax[i] = std::max(pmax[i], xfab.norm(bx,0,it.xcomp,it.ncomp));
+                    break;
+                case Norm1:
+                    psum[i] += xfab.norm(bx,1,it.xcomp,it.ncomp);
+                    break;
+                case Norm2:
+                    psum[i] += xfab.dot(bx,it.xcomp,xfab,bx,it.xcomp,it.ncomp);
+                    break;
+                }
+            }
+        }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp for
+#endif
+	for (int i=0; i<n; i++) {
+            for (int it=0; it<nthreads; it++) {
+	        sums[i] += priv_sums[it][i];
+	        maxs[i]  = std::max(maxs[i], priv_maxs[it][i]);
+            }
+	}
+    }
+
+    return mf0.color();
+}
+
+void
+MultiFabReduction::finish (const std::vector<Item>& items,
+                           const Array<Real>&       sums,
+                           const Array<Real>&       maxs,
+                           Array<Real>&             results)
+{
+    const int n = items.size();
+
+    results.resize(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        switch (items[i].kind)
+        {
+        case Norm0:
+            results[i] = maxs[i];              break;
+        case Norm2:
+            results[i] = std::sqrt(sums[i]);   break;
+        default:
+            results[i] = sums[i];
+        }
+    }
+}
+
+void
+MultiFabReduction::reduce (bool local)
+{
+    BL_PROFILE("MultiFabReduction::reduce()");
+
+    Array<Real> sums, maxs;
+
+    ParallelDescriptor::Color color = computeLocal(sums, maxs);
+
+    if (!local && !items.empty())
+    {
+        ParallelDescriptor::Message sum_msg = ParallelDescriptor::IReduceRealSum(sums.dataPtr(), sums.size(), color);
+        ParallelDescriptor::Message max_msg = ParallelDescriptor::IReduceRealMax(maxs.dataPtr(), maxs.size(), color);
+
+        sum_msg.wait();
+        max_msg.wait();
+    }
+
+    finish(items, sums, maxs, results);
+
+    reduced = true;
+}
+
+void
+MultiFabReduction::reduceLazy (std::function<void(const Array<Real>&)> f)
+{
+    BL_PROFILE("MultiFabReduction::reduceLazy()");
+
+    Array<Real> sums, maxs;
+
+    ParallelDescriptor::Color color = computeLocal(sums, maxs);
+
+    std::vector<Item> its = items;
+
+#ifdef BL_LAZY
+    Lazy::QueueReduction( [=] () mutable {
+#endif
+    if (!its.empty())
+    {
+        ParallelDescriptor::ReduceRealSum(sums.dataPtr(), sums.size(), color);
+        ParallelDescriptor::ReduceRealMax(maxs.dataPtr(), maxs.size(), color);
+    }
+
+    Array<Real> res;
+
+    finish(its, sums, maxs, res);
+
+    f(res);
+#ifdef BL_LAZY
+    });
+#endif
+}
+
+MultiFabUpdate::MultiFabUpdate (MultiFab& dstmf,
+                                int       dstcomp,
+                                int       num_comp,
+                                int       nghost)
+    :
+    dst(dstmf),
+    dcomp(dstcomp),
+    ncomp(num_comp),
+    ngrow(nghost),
+    dscale(0)
+{
+    BL_ASSERT(dcomp >= 0 && dcomp + ncomp <= dst.nComp());
+    BL_ASSERT(ngrow >= 0 && ngrow <= dst.nGrow());
+}
+
+MultiFabUpdate&
+MultiFabUpdate::scale (Real a)
+{
+    dscale = a;
+
+    return *this;
+}
+
+MultiFabUpdate&
+MultiFabUpdate::add (Real            a,
+                     const MultiFab& x,
+                     int             xcomp)
+{
+    BL_ASSERT(x.boxArray() == dst.boxArray());
+    BL_ASSERT(x.DistributionMap() == dst.DistributionMap());
+    BL_ASSERT(x.nGrow() >= ngrow);
+    BL_ASSERT(xcomp >= 0 && xcomp + ncomp <= x.nComp());
+    BL_ASSERT(&x != &dst || xcomp == dcomp);
+
+    const Term t = { a, &x, 0, xcomp, 0 };
+
+    terms.push_back(t);
+
+    return *this;
+}
+
+MultiFabUpdate&
+MultiFabUpdate::addProduct (Real            a,
+                            const MultiFab& x,
+                            int             xcomp,
+                            const MultiFab& y,
+                            int             ycomp)
+{
+    BL_ASSERT(x.boxArray() == dst.boxArray() && y.boxArray() == dst.boxArray());
+    BL_ASSERT(x.DistributionMap() == dst.DistributionMap());
+    BL_ASSERT(y.DistributionMap() == dst.DistributionMap());
+    BL_ASSERT(x.nGrow() >= ngrow && y.nGrow() >= ngrow);
+    BL_ASSERT(xcomp >= 0 && xcomp + ncomp <= x.nComp());
+    BL_ASSERT(ycomp >= 0 && ycomp + ncomp <= y.nComp());
+    BL_ASSERT(&x != &dst || xcomp == dcomp);
+    BL_ASSERT(&y != &dst || ycomp == dcomp);
+
+    const Term t = { a, &x, &y, xcomp, ycomp };
+
+    terms.push_back(t);
+
+    return *this;
+}
+
+void
+MultiFabUpdate::eval ()
+{
+    update(-1);
+}
+
+Real
+MultiFabUpdate::evalNorm (int  p,
+                          bool local)
+{
+    BL_ASSERT(p >= 0 && p <= 2);
+
+    Real nm = update(p);
+
+    if (!local)
+    {
+        if (p == 0)
+            ParallelDescriptor::ReduceRealMax(nm, dst.color());
+        else
+            ParallelDescriptor::ReduceRealSum(nm, dst.color());
+    }
+
+    return (p == 2) ? std::sqrt(nm) : nm;
+}
+
+Real
+MultiFabUpdate::update (int p)
+{
+    BL_PROFILE("MultiFabUpdate::update()");
+
+    const int nterms = terms.size();
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+#else
+    int nthreads = 1;
+#endif
+    Array<Real> priv_nm(nthreads, 0.0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+	int tid = omp_get_thread_num();
+#else
+	int tid = 0;
+#endif
+        Real& nm = priv_nm[tid];
+
+        std::vector<Real> row;
+
+	for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+	{
+            const Box& bx   = mfi.growntilebox(ngrow);
+            const Box& vbx  = mfi.tilebox();
+            const int* lo   = bx.loVect();
+            const int* hi   = bx.hiVect();
+            const int* vlo  = vbx.loVect();
+            const int* vhi  = vbx.hiVect();
+            const int  len  = bx.length(0);
+            FArrayBox& dfab = dst[mfi];
+
+            row.resize(len);
+
+            Real* r = &row[0];
+
+            for (int n = 0; n < ncomp; n++)
+            {
+#if (BL_SPACEDIM == 3)
+                for (int k = lo[2]; k <= hi[2]; k++)
+#endif
+#if (BL_SPACEDIM > 1)
+                for (int j = lo[1]; j <= hi[1]; j++)
+#endif
+                {
+                    const IntVect iv(D_DECL(lo[0],j,k));
+
+                    Real* d = &dfab(iv,dcomp+n);
+                    //
+                    // Accumulate the row, then store it; the terms may alias dst.
+                    //
+                    if (dscale == 0)
+                    {
+                        for (int i = 0; i < len; i++)
+                            r[i] = 0;
+                    }
+                    else
+                    {
+                        for (int i = 0; i < len; i++)
+                            r[i] = dscale*d[i];
+                    }
+
+                    for (int t = 0; t < nterms; t++)
+                    {
+                        const Term& tm = terms[t];
+                        const Real  a  = tm.a;
+                        const Real* x  = &(*tm.x)[mfi](iv,tm.xcomp+n);
+
+                        if (tm.y == 0)
+                        {
+                            for (int i = 0; i < len; i++)
+                                r[i] += a*x[i];
+                        }
+                        else
+                        {
+                            const Real* y = &(*tm.y)[mfi](iv,tm.ycomp+n);
+
+                            for (int i = 0; i < len; i++)
+                                r[i] += a*x[i]*y[i];
+                        }
+                    }
+
+                    for (int i = 0; i < len; i++)
+                        d[i] = r[i];
+
+                    if (p < 0) continue;
+
+                    bool valid = true;
+#if (BL_SPACEDIM > 1)
+                    valid = valid && j >= vlo[1] && j <= vhi[1];
+#endif
+#if (BL_SPACEDIM == 3)
+                    valid = valid && k >= vlo[2] && k <= vhi[2];
+#endif
+                    if (!valid) continue;
+
+                    const int ilo = vlo[0] - lo[0];
+                    const int ihi = vhi[0] - lo[0];
+
+                    if (p == 0)
+                    {
+                        for (int i = ilo; i <= ihi; i++)
+                            nm = std::max(nm, std::abs(r[i]));
+                    }
+                    else if (p == 1)
+                    {
+                        for (int i = ilo; i <= ihi; i++)
+                            nm += std::abs(r[i]);
+                    }
+                    else
+                    {
+                        for (int i = ilo; i <= ihi; i++)
+                            nm += r[i]*r[i];
+                    }
+                }
+            }
+        }
+    }
+
+    Real nm = 0;
+
+    for (int i = 0; i < nthreads; i++)
+        nm = (p == 0) ? std::max(nm, priv_nm[i]) : nm + priv_nm[i];
+
+    return nm;
+}
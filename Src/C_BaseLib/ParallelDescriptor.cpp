@@ -139,6 +139,8 @@ namespace ParallelDescriptor
 	void DoAllReduceLong     (long*      r, MPI_Op op, int cnt, Color color = DefaultColor());
 	void DoAllReduceInt      (int*       r, MPI_Op op, int cnt, Color color = DefaultColor());
 
+	Message DoIAllReduceReal (Real*      r, MPI_Op op, int cnt, Color color = DefaultColor());
+
 	void DoReduceReal     (Real&      r, MPI_Op op, int cpu);
 	void DoReduceLong     (long&      r, MPI_Op op, int cpu);
 	void DoReduceInt      (int&       r, MPI_Op op, int cpu);
@@ -1063,6 +1065,59 @@ ParallelDescriptor::ReduceRealSum (Real* r, int cnt, Color color)
     util::DoAllReduceReal(r,MPI_SUM,cnt,color);
 }
 
+ParallelDescriptor::Message
+ParallelDescriptor::util::DoIAllReduceReal (Real*  r,
+                                            MPI_Op op,
+                                            int    cnt,
+                                            Color  color)
+{
+    if (!isActive(color)) return Message();
+
+    BL_ASSERT(cnt > 0);
+
+#if (MPI_VERSION >= 3) && !defined(BL_USE_UPCXX)
+#ifdef BL_USE_MPI3
+    if (doTeamReduce() <= 1)
+#endif
+    {
+#ifdef BL_LAZY
+        Lazy::EvalReduction();
+#endif
+        BL_PROFILE_S("ParallelDescriptor::util::DoIAllReduceReal()");
+
+        MPI_Request req;
+
+        BL_MPI_REQUIRE( MPI_Iallreduce(MPI_IN_PLACE,
+                                       r,
+                                       cnt,
+                                       Mpi_typemap<Real>::type(),
+                                       op,
+                                       Communicator(color),
+                                       &req) );
+
+        return Message(req, Mpi_typemap<Real>::type());
+    }
+#endif
+    //
+    // No MPI_Iallreduce, or the reduction goes through the teams.
+    //
+    DoAllReduceReal(r,op,cnt,color);
+
+    return Message();
+}
+
+ParallelDescriptor::Message
+ParallelDescriptor::IReduceRealSum (Real* r, int cnt, Color color)
+{
+    return util::DoIAllReduceReal(r,MPI_SUM,cnt,color);
+}
+
+ParallelDescriptor::Message
+ParallelDescriptor::IReduceRealMax (Real* r, int cnt, Color color)
+{
+    return util::DoIAllReduceReal(r,MPI_MAX,cnt,color);
+}
+
 void
 ParallelDescriptor::ReduceRealMax (Real& r, int cpu)
 {
@@ -1985,6 +2040,9 @@ void ParallelDescriptor::ReduceRealMax (Real*,int,int) {}
 void ParallelDescriptor::ReduceRealMin (Real*,int,int) {}
 void ParallelDescriptor::ReduceRealSum (Real*,int,int) {}
 
+ParallelDescriptor::Message ParallelDescriptor::IReduceRealSum (Real*,int,Color) { return Message(); }
+ParallelDescriptor::Message ParallelDescriptor::IReduceRealMax (Real*,int,Color) { return Message(); }
+
 void ParallelDescriptor::ReduceLongAnd (long&,Color) {}
 void ParallelDescriptor::ReduceLongSum (long&,Color) {}
 void ParallelDescriptor::ReduceLongMax (long&,Color) {}
@@ -103,6 +103,20 @@ TinyProfiler::stop ()
     }
 }
 
+bool
+TinyProfiler::GetExclusiveTime (const std::string& fname, long& ncalls, Real& t)
+{
+    std::map<std::string, Stats>::const_iterator it = statsmap.find(fname);
+    if (it == statsmap.end()) {
+	ncalls = 0;
+	t = 0.0;
+	return false;
+    }
+    ncalls = it->second.n;
+    t = it->second.dtex;
+    return true;
+}
+
 void
 TinyProfiler::Initialize ()
 {
@@ -860,6 +860,33 @@ ParticleBase::Interp (const ParticleBase& prt,
     }
 }
 
+void
+ParticleBase::CIC_Stencil (const ParticleBase& prt,
+                           const Geometry&     geom,
+                           CICStencil&         st)
+{
+    ParticleBase::CIC_Cells_Fracs_Basic(prt, geom.ProbLo(), geom.CellSize(), st.fracs, st.cells);
+}
+
+void
+ParticleBase::Interp (const CICStencil& st,
+                      const FArrayBox&  fab,
+                      const int*        idx,
+                      Real*             val,
+                      int               cnt)
+{
+    BL_PROFILE("ParticleBase::Interp(stencil)");
+    BL_ASSERT(idx != 0);
+    BL_ASSERT(val != 0);
+
+    for (int i = 0; i < cnt; i++)
+    {
+        BL_ASSERT(idx[i] >= 0 && idx[i] < fab.nComp());
+
+        val[i] = ParticleBase::InterpDoit(fab,st.fracs,st.cells,idx[i]);
+    }
+}
+
 void
 ParticleBase::GetGravity (const FArrayBox&    gfab,
                           const Geometry&     geom,
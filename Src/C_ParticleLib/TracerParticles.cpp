@@ -19,6 +19,8 @@ TracerParticleContainer::AdvectWithUmac (MultiFab* umac, int lev, Real dt)
            BL_ASSERT(!umac[1].contains_nan());,
            BL_ASSERT(!umac[2].contains_nan()););
 
+    InvalidateInterpStencils();
+
     const Real      strttime = ParallelDescriptor::second();
     const Geometry& geom     = m_gdb->Geom(lev);
     const Real*     dx       = geom.CellSize();
@@ -154,6 +156,8 @@ TracerParticleContainer::AdvectWithUcc (const MultiFab& Ucc, int lev, Real dt)
 
     BL_ASSERT(!Ucc.contains_nan());
 
+    InvalidateInterpStencils();
+
     const Real      strttime = ParallelDescriptor::second();
     const Geometry& geom     = m_gdb->Geom(lev);
 
@@ -314,6 +318,8 @@ TracerParticleContainer::Timestamp (const std::string&      basename,
 
                 std::vector<Real> vals(M);
 
+                const bool cached = HasInterpStencils(lev);
+
 		for (const auto& kv : pmap)
                 {
                     const int        grid = kv.first;
@@ -321,8 +327,10 @@ TracerParticleContainer::Timestamp (const std::string&      basename,
                     const Box&       bx   = ba[grid];
                     const FArrayBox& fab  = mf[grid];
 
-		    for (const auto& p : pbox)
+		    for (int k = 0, N = pbox.size(); k < N; k++)
                     {
+                        const ParticleType& p = pbox[k];
+
                         if (p.m_id <= 0) continue;
 
                         const IntVect& iv = ParticleBase::Index(p, m_gdb->Geom(lev));
@@ -348,7 +356,10 @@ TracerParticleContainer::Timestamp (const std::string&      basename,
 
                         if (M > 0)
                         {
-                            ParticleBase::Interp(p,m_gdb->Geom(p.m_lev),fab,&indices[0],&vals[0],M);
+                            if (cached)
+                                ParticleBase::Interp(InterpStencil(lev,grid,k),fab,&indices[0],&vals[0],M);
+                            else
+                                ParticleBase::Interp(p,m_gdb->Geom(p.m_lev),fab,&indices[0],&vals[0],M);
 
                             for (int i = 0; i < M; i++)
                             {
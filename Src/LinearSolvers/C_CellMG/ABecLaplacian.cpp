@@ -127,6 +127,9 @@ ABecLaplacian::clearToLevel (int level)
       }
     }
     b_valid[i] = false;
+
+    clearHaloCoefficients(i);
+    clearSinglePrecisionCoefficients(i);
   }
 }
 
@@ -297,6 +300,10 @@ ABecLaplacian::invalidate_a_to_level (int lev)
     lev = (lev >= 0 ? lev : 0);
     for (int i = lev; i < numLevels(); i++)
         a_valid[i] = false;
+    for (int i = lev; i < halo_ngrow.size(); i++)
+        clearHaloCoefficients(i);
+    for (int i = lev; i < sp_acoefs.size(); i++)
+        clearSinglePrecisionCoefficients(i);
 }
 
 void
@@ -305,6 +312,10 @@ ABecLaplacian::invalidate_b_to_level (int lev)
     lev = (lev >= 0 ? lev : 0);
     for (int i = lev; i < numLevels(); i++)
         b_valid[i] = false;
+    for (int i = lev; i < halo_ngrow.size(); i++)
+        clearHaloCoefficients(i);
+    for (int i = lev; i < sp_acoefs.size(); i++)
+        clearSinglePrecisionCoefficients(i);
 }
 
 void
@@ -513,6 +524,488 @@ ABecLaplacian::Fsmooth (MultiFab&       solnL,
     }
 }
 
+void
+ABecLaplacian::clearHaloCoefficients (int level)
+{
+    if (level >= halo_ngrow.size()) return;
+
+    halo_ngrow[level] = 0;
+
+    delete halo_acoefs[level];
+    halo_acoefs[level] = 0;
+
+    for (int i = 0; i < BL_SPACEDIM; ++i)
+    {
+        delete halo_bcoefs[level][i];
+        halo_bcoefs[level][i] = 0;
+    }
+
+    delete halo_phi[level];
+    halo_phi[level] = 0;
+
+    delete halo_rhs[level];
+    halo_rhs[level] = 0;
+}
+
+bool
+ABecLaplacian::buildHaloCoefficients (int level, int ngrow)
+{
+    if (level < halo_ngrow.size() && halo_ngrow[level] != 0)
+    {
+        if (halo_ngrow[level] < 0)
+            return false;
+        if (halo_ngrow[level] >= ngrow)
+            return true;
+    }
+
+    BL_PROFILE("ABecLaplacian::buildHaloCoefficients()");
+
+    if (halo_ngrow.size() < level+1)
+    {
+        const int oldsize = halo_ngrow.size();
+
+        halo_acoefs.resize(level+1);
+        halo_bcoefs.resize(level+1);
+        halo_phi.resize(level+1);
+        halo_rhs.resize(level+1);
+        halo_ngrow.resize(level+1);
+
+        for (int l = oldsize; l <= level; ++l)
+        {
+            halo_acoefs[l] = 0;
+            for (int i = 0; i < BL_SPACEDIM; ++i)
+                halo_bcoefs[l][i] = 0;
+            halo_phi[l] = 0;
+            halo_rhs[l] = 0;
+            halo_ngrow[l] = 0;
+        }
+    }
+
+    clearHaloCoefficients(level);
+    //
+    // The halo cells must be valid cells of other grids.  The grids must
+    // cover the domain, and it must be periodic: cells next to a physical
+    // boundary need the boundary terms of FORT_GSRB, which the halo kernel
+    // doesn't have.
+    //
+    if (!gbox[level].contains(geomarray[level].Domain()) || !geomarray[level].isAllPeriodic())
+    {
+        halo_ngrow[level] = -1;
+        return false;
+    }
+
+    const Periodicity& period = geomarray[level].periodicity();
+
+    const MultiFab& a = aCoefficients(level);
+
+    halo_acoefs[level] = new MultiFab(a.boxArray(), 1, ngrow, a.DistributionMap());
+    halo_acoefs[level]->setVal(0);
+    MultiFab::Copy(*halo_acoefs[level], a, 0, 0, 1, 0);
+    halo_acoefs[level]->FillBoundary(period);
+
+    for (int i = 0; i < BL_SPACEDIM; ++i)
+    {
+        const MultiFab& b = bCoefficients(i,level);
+
+        halo_bcoefs[level][i] = new MultiFab(b.boxArray(), 1, ngrow, b.DistributionMap());
+        halo_bcoefs[level][i]->setVal(0);
+        MultiFab::Copy(*halo_bcoefs[level][i], b, 0, 0, 1, 0);
+        halo_bcoefs[level][i]->FillBoundary(period);
+    }
+    //
+    // Scratch for the solution and right hand side, reused by every call.
+    //
+    halo_phi[level] = new MultiFab(a.boxArray(), 1, ngrow+1, a.DistributionMap());
+    halo_rhs[level] = new MultiFab(a.boxArray(), 1, ngrow,   a.DistributionMap());
+
+    halo_ngrow[level] = ngrow;
+
+    return true;
+}
+
+void
+ABecLaplacian::smoothDeepHalo (MultiFab&       solnL,
+                               const MultiFab& rhsL,
+                               int             level,
+                               LinOp::BC_Mode  bc_mode,
+                               int             nsmooth,
+                               int             depth)
+{
+#if (BL_SPACEDIM == 1)
+    //
+    // There is no GSRB kernel in 1D.
+    //
+    depth = 1;
+#elif (BL_SPACEDIM == 2)
+    //
+    // FORT_GSRB switches to line solves on anisotropic grids.
+    //
+    const Real* hl = h[level];
+
+    if (hl[1] > 1.5*hl[0] || hl[0] > 1.5*hl[1])
+        depth = 1;
+#endif
+
+    if (depth > 1 && nsmooth > 0)
+    {
+        prepareForLevel(level);
+
+        if (!buildHaloCoefficients(level, depth-1))
+            depth = 1;
+    }
+
+    if (depth <= 1 || nsmooth <= 0)
+    {
+        LinOp::smoothDeepHalo(solnL, rhsL, level, bc_mode, nsmooth, depth);
+        return;
+    }
+
+    BL_PROFILE("ABecLaplacian::smoothDeepHalo()");
+
+    const Periodicity& period = geomarray[level].periodicity();
+
+    MultiFab& phi = *halo_phi[level];
+    MultiFab& rhs = *halo_rhs[level];
+
+    BL_ASSERT(phi.boxArray() == solnL.boxArray());
+    BL_ASSERT(phi.nGrow() >= depth);
+
+    MultiFab::Copy(phi, solnL, 0, 0, 1, 0);
+    MultiFab::Copy(rhs, rhsL,  0, 0, 1, 0);
+
+    rhs.FillBoundary(period);
+
+    const MultiFab& a = *halo_acoefs[level];
+
+    D_TERM(const MultiFab& bX = *halo_bcoefs[level][0];,
+           const MultiFab& bY = *halo_bcoefs[level][1];,
+           const MultiFab& bZ = *halo_bcoefs[level][2];);
+
+    const int nc = 1;
+
+    const bool tiling = true;
+
+    int redBlackFlag = 0;
+
+    for (int nhalf = 2*nsmooth; nhalf > 0; )
+    {
+        const int nsweep = std::min(nhalf, depth);
+        //
+        // One exchange for nsweep half-sweeps.
+        //
+        phi.FillBoundary(period);
+
+        for (int s = 0; s < nsweep; ++s)
+        {
+            applyPhysBC(phi, 0, 1, level, bc_mode);
+
+            Fsmooth(phi, rhs, level, redBlackFlag);
+            //
+            // Relax the halo cells still needed by the remaining sweeps.
+            //
+            const int r = nsweep - 1 - s;
+
+            if (r > 0)
+            {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(phi,tiling); mfi.isValid(); ++mfi)
+                {
+                    const Box& tbx = mfi.growntilebox(r);
+
+                    const Box&       vbx     = mfi.validbox();
+                    FArrayBox&       phifab  = phi[mfi];
+                    const FArrayBox& rhsfab  = rhs[mfi];
+                    const FArrayBox& afab    = a[mfi];
+
+                    D_TERM(const FArrayBox& bxfab = bX[mfi];,
+                           const FArrayBox& byfab = bY[mfi];,
+                           const FArrayBox& bzfab = bZ[mfi];);
+
+#if (BL_SPACEDIM > 1)
+                    FORT_GSRB_HALO(phifab.dataPtr(), ARLIM(phifab.loVect()), ARLIM(phifab.hiVect()),
+                                   rhsfab.dataPtr(), ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+                                   &alpha, &beta,
+                                   afab.dataPtr(), ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+                                   bxfab.dataPtr(), ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+                                   byfab.dataPtr(), ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+#if (BL_SPACEDIM == 3)
+                                   bzfab.dataPtr(), ARLIM(bzfab.loVect()), ARLIM(bzfab.hiVect()),
+#endif
+                                   tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+                                   &nc, h[level], &redBlackFlag);
+#endif
+                }
+            }
+
+            redBlackFlag = 1 - redBlackFlag;
+        }
+
+        nhalf -= nsweep;
+    }
+
+    MultiFab::Copy(solnL, phi, 0, 0, 1, 0);
+}
+
+void
+ABecLaplacian::clearSinglePrecisionCoefficients (int level)
+{
+    if (level >= sp_acoefs.size()) return;
+
+    delete sp_acoefs[level];
+    sp_acoefs[level] = 0;
+
+    for (int i = 0; i < BL_SPACEDIM; ++i)
+    {
+        delete sp_bcoefs[level][i];
+        sp_bcoefs[level][i] = 0;
+    }
+}
+
+static
+void
+CopyToFloat (LinOp::FloatMultiFab& dst,
+             const MultiFab&       src)
+{
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(src); mfi.isValid(); ++mfi)
+    {
+        const FArrayBox& sfab = src[mfi];
+        BaseFab<float>&  dfab = dst[mfi];
+
+        BL_ASSERT(sfab.box() == dfab.box());
+
+        const Real* sp = sfab.dataPtr();
+        float*      dp = dfab.dataPtr();
+        const long  N  = sfab.box().numPts();
+
+        for (long n = 0; n < N; ++n)
+            dp[n] = sp[n];
+    }
+}
+
+void
+ABecLaplacian::buildSinglePrecisionCoefficients (int level)
+{
+    if (level < sp_acoefs.size() && sp_acoefs[level] != 0) return;
+
+    BL_PROFILE("ABecLaplacian::buildSinglePrecisionCoefficients()");
+
+    if (sp_acoefs.size() < level+1)
+    {
+        const int oldsize = sp_acoefs.size();
+
+        sp_acoefs.resize(level+1);
+        sp_bcoefs.resize(level+1);
+
+        for (int l = oldsize; l <= level; ++l)
+        {
+            sp_acoefs[l] = 0;
+            for (int i = 0; i < BL_SPACEDIM; ++i)
+                sp_bcoefs[l][i] = 0;
+        }
+    }
+
+    const MultiFab& a = aCoefficients(level);
+
+    sp_acoefs[level] = new FloatMultiFab(a.boxArray(), 1, a.nGrow(), a.DistributionMap());
+    CopyToFloat(*sp_acoefs[level], a);
+
+    for (int i = 0; i < BL_SPACEDIM; ++i)
+    {
+        const MultiFab& b = bCoefficients(i,level);
+
+        sp_bcoefs[level][i] = new FloatMultiFab(b.boxArray(), 1, b.nGrow(), b.DistributionMap());
+        CopyToFloat(*sp_bcoefs[level][i], b);
+    }
+}
+
+void
+ABecLaplacian::smoothSP (FloatMultiFab&       solnL,
+                         const FloatMultiFab& rhsL,
+                         int                  level)
+{
+#if (BL_SPACEDIM == 1)
+    LinOp::smoothSP(solnL, rhsL, level);
+#else
+    prepareForLevel(level);
+
+    buildSinglePrecisionCoefficients(level);
+
+    for (int redBlackFlag = 0; redBlackFlag < 2; redBlackFlag++)
+    {
+        applyBCSP(solnL, level);
+        FsmoothSP(solnL, rhsL, level, redBlackFlag);
+    }
+#endif
+}
+
+void
+ABecLaplacian::residualSP (FloatMultiFab&       residL,
+                           const FloatMultiFab& rhsL,
+                           FloatMultiFab&       solnL,
+                           int                  level)
+{
+#if (BL_SPACEDIM == 1)
+    LinOp::residualSP(residL, rhsL, solnL, level);
+#else
+    BL_PROFILE("ABecLaplacian::residualSP()");
+
+    prepareForLevel(level);
+
+    buildSinglePrecisionCoefficients(level);
+
+    applyBCSP(solnL, level);
+
+    const FloatMultiFab& a = *sp_acoefs[level];
+
+    D_TERM(const FloatMultiFab& bX = *sp_bcoefs[level][0];,
+           const FloatMultiFab& bY = *sp_bcoefs[level][1];,
+           const FloatMultiFab& bZ = *sp_bcoefs[level][2];);
+
+    const bool tiling = true;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(residL,tiling); mfi.isValid(); ++mfi)
+    {
+        const Box&            tbx     = mfi.tilebox();
+        BaseFab<float>&       resfab  = residL[mfi];
+        const BaseFab<float>& rhsfab  = rhsL[mfi];
+        const BaseFab<float>& solnfab = solnL[mfi];
+        const BaseFab<float>& afab    = a[mfi];
+
+        D_TERM(const BaseFab<float>& bxfab = bX[mfi];,
+               const BaseFab<float>& byfab = bY[mfi];,
+               const BaseFab<float>& bzfab = bZ[mfi];);
+
+#if (BL_SPACEDIM == 2)
+        FORT_RESID_SP(resfab.dataPtr(), ARLIM(resfab.loVect()), ARLIM(resfab.hiVect()),
+                      rhsfab.dataPtr(), ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+                      solnfab.dataPtr(), ARLIM(solnfab.loVect()), ARLIM(solnfab.hiVect()),
+                      &alpha, &beta,
+                      afab.dataPtr(), ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+                      bxfab.dataPtr(), ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+                      byfab.dataPtr(), ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+                      tbx.loVect(), tbx.hiVect(), h[level]);
+#endif
+
+#if (BL_SPACEDIM == 3)
+        FORT_RESID_SP(resfab.dataPtr(), ARLIM(resfab.loVect()), ARLIM(resfab.hiVect()),
+                      rhsfab.dataPtr(), ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+                      solnfab.dataPtr(), ARLIM(solnfab.loVect()), ARLIM(solnfab.hiVect()),
+                      &alpha, &beta,
+                      afab.dataPtr(), ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+                      bxfab.dataPtr(), ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+                      byfab.dataPtr(), ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+                      bzfab.dataPtr(), ARLIM(bzfab.loVect()), ARLIM(bzfab.hiVect()),
+                      tbx.loVect(), tbx.hiVect(), h[level]);
+#endif
+    }
+#endif
+}
+
+#if (BL_SPACEDIM > 1)
+void
+ABecLaplacian::FsmoothSP (FloatMultiFab&       solnL,
+                          const FloatMultiFab& rhsL,
+                          int                  level,
+                          int                  redBlackFlag)
+{
+    BL_PROFILE("ABecLaplacian::FsmoothSP()");
+
+    const FloatMultiFab& a = *sp_acoefs[level];
+
+    D_TERM(const FloatMultiFab& bX = *sp_bcoefs[level][0];,
+           const FloatMultiFab& bY = *sp_bcoefs[level][1];,
+           const FloatMultiFab& bZ = *sp_bcoefs[level][2];);
+
+    OrientationIter oitr;
+    const MultiMask& mm0 = maskvals[level][oitr()]; oitr++;
+    const MultiMask& mm1 = maskvals[level][oitr()]; oitr++;
+    const MultiMask& mm2 = maskvals[level][oitr()]; oitr++;
+    const MultiMask& mm3 = maskvals[level][oitr()]; oitr++;
+#if (BL_SPACEDIM > 2)
+    const MultiMask& mm4 = maskvals[level][oitr()]; oitr++;
+    const MultiMask& mm5 = maskvals[level][oitr()]; oitr++;
+#endif
+
+    const bool tiling = true;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter solnLmfi(solnL,tiling); solnLmfi.isValid(); ++solnLmfi)
+    {
+        const int gn = solnLmfi.index();
+
+        const Mask& m0 = mm0[solnLmfi];
+        const Mask& m1 = mm1[solnLmfi];
+        const Mask& m2 = mm2[solnLmfi];
+        const Mask& m3 = mm3[solnLmfi];
+#if (BL_SPACEDIM > 2)
+        const Mask& m4 = mm4[solnLmfi];
+        const Mask& m5 = mm5[solnLmfi];
+#endif
+        //
+        // The relaxation coefficient of each face, ordered like the f#.
+        //
+        float den[2*BL_SPACEDIM];
+        for (OrientationIter fi; fi; ++fi)
+            den[fi()] = homogeneousBndryCoef(gn, fi(), level);
+
+        const Box&            tbx     = solnLmfi.tilebox();
+        const Box&            vbx     = solnLmfi.validbox();
+        BaseFab<float>&       solnfab = solnL[solnLmfi];
+        const BaseFab<float>& rhsfab  = rhsL[solnLmfi];
+        const BaseFab<float>& afab    = a[solnLmfi];
+
+        D_TERM(const BaseFab<float>& bxfab = bX[solnLmfi];,
+               const BaseFab<float>& byfab = bY[solnLmfi];,
+               const BaseFab<float>& bzfab = bZ[solnLmfi];);
+
+#if (BL_SPACEDIM == 2)
+        FORT_GSRB_SP(solnfab.dataPtr(), ARLIM(solnfab.loVect()), ARLIM(solnfab.hiVect()),
+                     rhsfab.dataPtr(), ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+                     &alpha, &beta,
+                     afab.dataPtr(), ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+                     bxfab.dataPtr(), ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+                     byfab.dataPtr(), ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+                     m0.dataPtr(), ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
+                     m1.dataPtr(), ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
+                     m2.dataPtr(), ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
+                     m3.dataPtr(), ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
+                     den,
+                     tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+                     h[level], &redBlackFlag);
+#endif
+
+#if (BL_SPACEDIM == 3)
+        FORT_GSRB_SP(solnfab.dataPtr(), ARLIM(solnfab.loVect()), ARLIM(solnfab.hiVect()),
+                     rhsfab.dataPtr(), ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+                     &alpha, &beta,
+                     afab.dataPtr(), ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+                     bxfab.dataPtr(), ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+                     byfab.dataPtr(), ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+                     bzfab.dataPtr(), ARLIM(bzfab.loVect()), ARLIM(bzfab.hiVect()),
+                     m0.dataPtr(), ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
+                     m1.dataPtr(), ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
+                     m2.dataPtr(), ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
+                     m3.dataPtr(), ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
+                     m4.dataPtr(), ARLIM(m4.loVect()), ARLIM(m4.hiVect()),
+                     m5.dataPtr(), ARLIM(m5.loVect()), ARLIM(m5.hiVect()),
+                     den,
+                     tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+                     h[level], &redBlackFlag);
+#endif
+    }
+}
+#endif
+
 void
 ABecLaplacian::Fsmooth_jacobi (MultiFab&       solnL,
                                const MultiFab& rhsL,
@@ -706,3 +1199,52 @@ ABecLaplacian::Fapply (MultiFab&       y,
 #endif
     }
 }
+
+void
+ABecLaplacian::FapplyTile (FArrayBox&       yfab,
+                           const FArrayBox& xfab,
+                           const Box&       tbx,
+                           int              gridno,
+                           int              level)
+{
+    BL_ASSERT(level < acoefs.size() && level < bcoefs.size());
+
+    const int num_comp = 1;
+
+    const FArrayBox& afab = (*acoefs[level])[gridno];
+
+    D_TERM(const FArrayBox& bxfab = (*bcoefs[level][0])[gridno];,
+           const FArrayBox& byfab = (*bcoefs[level][1])[gridno];,
+           const FArrayBox& bzfab = (*bcoefs[level][2])[gridno];);
+
+#if (BL_SPACEDIM == 2)
+    FORT_ADOTX(yfab.dataPtr(),
+               ARLIM(yfab.loVect()),ARLIM(yfab.hiVect()),
+               xfab.dataPtr(),
+               ARLIM(xfab.loVect()), ARLIM(xfab.hiVect()),
+               &alpha, &beta, afab.dataPtr(), 
+               ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+               bxfab.dataPtr(), 
+               ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+               byfab.dataPtr(), 
+               ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+               tbx.loVect(), tbx.hiVect(), &num_comp,
+               h[level]);
+#endif
+#if (BL_SPACEDIM ==3)
+    FORT_ADOTX(yfab.dataPtr(),
+               ARLIM(yfab.loVect()), ARLIM(yfab.hiVect()),
+               xfab.dataPtr(),
+               ARLIM(xfab.loVect()), ARLIM(xfab.hiVect()),
+               &alpha, &beta, afab.dataPtr(), 
+               ARLIM(afab.loVect()), ARLIM(afab.hiVect()),
+               bxfab.dataPtr(), 
+               ARLIM(bxfab.loVect()), ARLIM(bxfab.hiVect()),
+               byfab.dataPtr(), 
+               ARLIM(byfab.loVect()), ARLIM(byfab.hiVect()),
+               bzfab.dataPtr(), 
+               ARLIM(bzfab.loVect()), ARLIM(bzfab.hiVect()),
+               tbx.loVect(), tbx.hiVect(), &num_comp,
+               h[level]);
+#endif
+}
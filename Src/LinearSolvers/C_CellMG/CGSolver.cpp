@@ -81,6 +81,8 @@ CGSolver::Initialize ()
         case 0: def_cg_solver = CG;             break;
         case 1: def_cg_solver = BiCGStab;       break;
         case 2: def_cg_solver = CABiCGStab;     break;
+        case 3: def_cg_solver = PipeCG;         break;
+        case 4: def_cg_solver = PipeBiCGStab;   break;
         default:
             BoxLib::Error("CGSolver::Initialize(): bad cg_solver");
         }
@@ -155,6 +157,25 @@ norm_inf (const MultiFab& res, bool local = false)
     return res.norm0(0,0,local);
 }
 
+//
+// Max norms of two MultiFabs with a single reduction.
+//
+static
+void
+norm_inf (const MultiFab& x, Real& xnorm,
+          const MultiFab& y, Real& ynorm)
+{
+    MultiFabReduction red;
+
+    const int ix = red.addNorm0(x, 0);
+    const int iy = red.addNorm0(y, 0);
+
+    red.reduce();
+
+    xnorm = red[ix];
+    ynorm = red[iy];
+}
+
 int
 CGSolver::solve (MultiFab&       sol,
                  const MultiFab& rhs,
@@ -170,6 +191,10 @@ CGSolver::solve (MultiFab&       sol,
         return solve_bicgstab(sol, rhs, eps_rel, eps_abs, bc_mode);
     case CABiCGStab:
         return solve_cabicgstab(sol, rhs, eps_rel, eps_abs, bc_mode);
+    case PipeCG:
+        return solve_pipecg(sol, rhs, eps_rel, eps_abs, bc_mode);
+    case PipeBiCGStab:
+        return solve_pipebicgstab(sol, rhs, eps_rel, eps_abs, bc_mode);
     default:
         BoxLib::Error("CGSolver::solve(): unknown solver");
     }
@@ -896,9 +921,14 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         return ret;
     }
 
+    //
+    // rho for the next iteration is reduced together with the norms at the
+    // end of this one.
+    //
+    Real rho = dotxy(rh,r);
+
     for (; nit <= maxiter; ++nit)
     {
-        const Real rho = dotxy(rh,r);
         if ( rho == 0 ) 
 	{
             ret = 1; break;
@@ -940,7 +970,11 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         sxay(sol, sol,  alpha, ph);
         sxay(s,     r, -alpha,  v);
 
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         rnorm = norm_inf(s);
+#else
+        norm_inf(s, rnorm, sol, sol_norm);
+#endif
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -954,7 +988,6 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( use_mg_precond )
@@ -992,7 +1025,23 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         sxay(sol, sol,  omega, sh);
         sxay(r,     s, -omega,  t);
 
-        rnorm = norm_inf(r);
+        rho_1 = rho;
+        {
+            MultiFabReduction red;
+
+            const int i_rho   = red.addDot(rh, 0, r, 0);
+            const int i_rnorm = red.addNorm0(r, 0);
+#ifndef CG_USE_OLD_CONVERGENCE_CRITERIA
+            const int i_snorm = red.addNorm0(sol, 0);
+#endif
+            red.reduce();
+
+            rho   = red[i_rho];
+            rnorm = red[i_rnorm];
+#ifndef CG_USE_OLD_CONVERGENCE_CRITERIA
+            sol_norm = red[i_snorm];
+#endif
+        }
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -1006,14 +1055,12 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( omega == 0 )
 	{
             ret = 4; break;
 	}
-        rho_1 = rho;
     }
 
     if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
@@ -1049,6 +1096,575 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
     return ret;
 }
 
+//
+// Apply the preconditioner, if any, to in.  Returns false if there is none,
+// in which case out is untouched.
+//
+bool
+CGSolver::precondition (MultiFab&       out,
+                        const MultiFab& in,
+                        Real            eps_rel,
+                        Real            eps_abs)
+{
+    const LinOp::BC_Mode temp_bc_mode = LinOp::Homogeneous_BC;
+
+    if ( use_mg_precond )
+    {
+        out.setVal(0);
+        mg_precond->solve(out, in, eps_rel, eps_abs, temp_bc_mode);
+        return true;
+    }
+    else if ( use_jacobi_precond )
+    {
+        out.setVal(0);
+        Lp.jacobi_smooth(out, in, lev, temp_bc_mode);
+        return true;
+    }
+    return false;
+}
+
+//
+// Pipelined CG (Ghysels & Vanroose, Parallel Computing 40, 2014).  The two
+// dot products and the norms of an iteration are reduced together with a
+// non-blocking allreduce which is overlapped with the preconditioner and
+// the operator application.  Needs one more operator application than
+// solve_cg() to get started, and more vectors.
+//
+int
+CGSolver::solve_pipecg (MultiFab&       sol,
+                        const MultiFab& rhs,
+                        Real            eps_rel,
+                        Real            eps_abs,
+                        LinOp::BC_Mode  bc_mode)
+{
+    BL_PROFILE("CGSolver::solve_pipecg()");
+
+    const int nghost = sol.nGrow(), ncomp = 1;
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+
+    BL_ASSERT(sol.nComp() == ncomp);
+    BL_ASSERT(sol.boxArray() == Lp.boxArray(lev));
+    BL_ASSERT(rhs.boxArray() == Lp.boxArray(lev));
+    //
+    // The Jacobi smoother is the only symmetric preconditioner we have.
+    //
+    const bool precond = use_jacobi_precond;
+
+    if ( use_mg_precond && ParallelDescriptor::IOProcessor(color()) )
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            std::cout << "CGSolver_PipeCG: warning: use_mg_precond is ignored;"
+                      << " only cg.use_jacobi_precond is supported\n";
+            warned = true;
+        }
+    }
+
+    MultiFab sorig(ba, ncomp, 0,      dm);
+    MultiFab r    (ba, ncomp, nghost, dm);
+    MultiFab w    (ba, ncomp, nghost, dm);
+    MultiFab n    (ba, ncomp, 0,      dm);
+    MultiFab p    (ba, ncomp, 0,      dm);
+    MultiFab s    (ba, ncomp, 0,      dm);
+    MultiFab z    (ba, ncomp, 0,      dm);
+    //
+    // The preconditioned u = M r, m = M w and q = M s; without a
+    // preconditioner they are r, w and s.
+    //
+    PArray<MultiFab> pvecs(3, PArrayManage);
+
+    if ( precond )
+    {
+        pvecs.set(0, new MultiFab(ba, ncomp, nghost, dm));
+        pvecs.set(1, new MultiFab(ba, ncomp, nghost, dm));
+        pvecs.set(2, new MultiFab(ba, ncomp, 0,      dm));
+    }
+
+    MultiFab& u = precond ? pvecs[0] : r;
+    MultiFab& m = precond ? pvecs[1] : w;
+    MultiFab& q = precond ? pvecs[2] : s;
+
+    Lp.residual(r, rhs, sol, lev, bc_mode);
+
+    MultiFab::Copy(sorig,sol,0,0,1,0);
+
+    sol.setVal(0);
+
+    const LinOp::BC_Mode temp_bc_mode = LinOp::Homogeneous_BC;
+
+    Real vals[2] = { norm_inf(r, true), Lp.norm(0, lev, true) };
+
+    ParallelDescriptor::ReduceRealMax(vals,2,color());
+
+    Real       rnorm    = vals[0];
+    const Real rnorm0   = rnorm;
+    const Real Lp_norm  = vals[1];
+    Real       sol_norm = 0;
+    Real       minrnorm = rnorm;
+
+    if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+    {
+        Spacer(std::cout, lev);
+        std::cout << "CGSolver_PipeCG: Initial error (error0) =        " << rnorm0 << '\n';
+    }
+
+    int ret = 0, nit = 1;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+	{
+            Spacer(std::cout, lev);
+            std::cout << "CGSolver_PipeCG: niter = 0,"
+                      << ", rnorm = " << rnorm 
+                      << ", eps_abs = " << eps_abs << std::endl;
+	}
+        return ret;
+    }
+
+    if ( precond )
+    {
+        u.setVal(0);
+        Lp.jacobi_smooth(u, r, lev, temp_bc_mode);
+    }
+
+    Lp.apply(w, u, lev, temp_bc_mode);
+
+    Real gamma_1 = 0, alpha = 0;
+
+    for (; nit <= maxiter; ++nit)
+    {
+        //
+        // gamma = (r,u), delta = (w,u), and the norms of r and sol.
+        //
+        Real sums[2] = { dotxy(r,u,true), dotxy(w,u,true) };
+        Real maxs[2] = { norm_inf(r,true), norm_inf(sol,true) };
+
+        ParallelDescriptor::Message sum_msg = ParallelDescriptor::IReduceRealSum(sums,2,color());
+        ParallelDescriptor::Message max_msg = ParallelDescriptor::IReduceRealMax(maxs,2,color());
+
+        if ( precond )
+        {
+            m.setVal(0);
+            Lp.jacobi_smooth(m, w, lev, temp_bc_mode);
+        }
+
+        Lp.apply(n, m, lev, temp_bc_mode);
+
+        sum_msg.wait();
+        max_msg.wait();
+
+        rnorm    = maxs[0];
+        sol_norm = maxs[1];
+
+        if ( verbose > 2 && nit > 1 && ParallelDescriptor::IOProcessor(color()) )
+        {
+            Spacer(std::cout, lev);
+            std::cout << "CGSolver_PipeCG: Iteration "
+                      << std::setw(11) << nit-1
+                      << " rel. err. "
+                      << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( nit > 1 )
+        {
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+            if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+#else
+            if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0) || rnorm < eps_abs ) break;
+#endif
+            if ( rnorm > def_unstable_criterion*minrnorm )
+            {
+                ret = 2; break;
+            }
+            else if ( rnorm < minrnorm )
+            {
+                minrnorm = rnorm;
+            }
+        }
+
+        const Real gamma = sums[0];
+        const Real delta = sums[1];
+
+        Real beta = 0, denom = delta;
+
+        if ( nit > 1 )
+        {
+            beta  = gamma/gamma_1;
+            denom = delta - beta*gamma/alpha;
+        }
+
+        if ( denom == 0 )
+        {
+            ret = 1; break;
+        }
+
+        alpha = gamma/denom;
+
+        if ( nit == 1 )
+        {
+            MultiFab::Copy(z,n,0,0,1,0);
+            MultiFab::Copy(s,w,0,0,1,0);
+            MultiFab::Copy(p,u,0,0,1,0);
+            if ( precond )
+                MultiFab::Copy(q,m,0,0,1,0);
+        }
+        else
+        {
+            sxay(z, n, beta, z);
+            sxay(s, w, beta, s);
+            sxay(p, u, beta, p);
+            if ( precond )
+                sxay(q, m, beta, q);
+        }
+
+        sxay(sol, sol,  alpha, p);
+        sxay(r,   r,   -alpha, s);
+        sxay(w,   w,   -alpha, z);
+        if ( precond )
+            sxay(u, u, -alpha, q);
+
+        gamma_1 = gamma;
+    }
+    //
+    // Leaving the loop through maxiter skips the last convergence check.
+    //
+    if ( nit > maxiter )
+    {
+        Real maxs[2] = { norm_inf(r,true), norm_inf(sol,true) };
+
+        ParallelDescriptor::ReduceRealMax(maxs,2,color());
+
+        rnorm    = maxs[0];
+        sol_norm = maxs[1];
+    }
+
+    if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+    {
+        Spacer(std::cout, lev);
+        std::cout << "CGSolver_PipeCG: Final: Iteration "
+                  << std::setw(4) << nit-1
+                  << " rel. err. "
+                  << rnorm/(rnorm0) << '\n';
+    }
+
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+    if ( ret == 0 && rnorm > eps_rel*rnorm0 && rnorm > eps_abs)
+#else
+    if ( ret == 0 && rnorm > eps_rel*(Lp_norm*sol_norm + rnorm0 ) && rnorm > eps_abs )
+#endif
+    {
+        if ( ParallelDescriptor::IOProcessor(color()) )
+            BoxLib::Warning("CGSolver_PipeCG:: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, 1, 0);
+    } 
+    else 
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, 1, 0);
+    }
+
+    return ret;
+}
+
+//
+// Pipelined BiCGStab (Cools & Vanroose, Parallel Computing 65, 2017), right
+// preconditioned.  Each iteration has two non-blocking reductions, one
+// overlapped with the preconditioner and operator applied to z, the other
+// with those applied to w.  The hatted vectors are the preconditioned ones;
+// without a preconditioner they are the unhatted ones.
+//
+int
+CGSolver::solve_pipebicgstab (MultiFab&       sol,
+                              const MultiFab& rhs,
+                              Real            eps_rel,
+                              Real            eps_abs,
+                              LinOp::BC_Mode  bc_mode)
+{
+    BL_PROFILE("CGSolver::solve_pipebicgstab()");
+
+    const int nghost = sol.nGrow(), ncomp = 1;
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+
+    BL_ASSERT(sol.nComp() == ncomp);
+    BL_ASSERT(sol.boxArray() == Lp.boxArray(lev));
+    BL_ASSERT(rhs.boxArray() == Lp.boxArray(lev));
+
+    const bool precond = use_mg_precond || use_jacobi_precond;
+
+    MultiFab sorig(ba, ncomp, 0,      dm);
+    MultiFab rh   (ba, ncomp, 0,      dm);
+    MultiFab r    (ba, ncomp, nghost, dm);
+    MultiFab w    (ba, ncomp, nghost, dm);
+    MultiFab t    (ba, ncomp, 0,      dm);
+    MultiFab p    (ba, ncomp, 0,      dm);
+    MultiFab s    (ba, ncomp, 0,      dm);
+    MultiFab z    (ba, ncomp, nghost, dm);
+    MultiFab q    (ba, ncomp, 0,      dm);
+    MultiFab y    (ba, ncomp, 0,      dm);
+    MultiFab v    (ba, ncomp, 0,      dm);
+
+    PArray<MultiFab> hats(5, PArrayManage);
+
+    if ( precond )
+    {
+        hats.set(0, new MultiFab(ba, ncomp, nghost, dm));
+        hats.set(1, new MultiFab(ba, ncomp, nghost, dm));
+        hats.set(2, new MultiFab(ba, ncomp, 0,      dm));
+        hats.set(3, new MultiFab(ba, ncomp, nghost, dm));
+        hats.set(4, new MultiFab(ba, ncomp, 0,      dm));
+    }
+
+    MultiFab& rhat = precond ? hats[0] : r;
+    MultiFab& what = precond ? hats[1] : w;
+    MultiFab& phat = precond ? hats[2] : p;
+    MultiFab& zhat = precond ? hats[3] : z;
+    MultiFab& shat = precond ? hats[4] : s;
+
+    Lp.residual(r, rhs, sol, lev, bc_mode);
+
+    MultiFab::Copy(sorig,sol,0,0,1,0);
+    MultiFab::Copy(rh,   r,  0,0,1,0);
+
+    sol.setVal(0);
+
+    const LinOp::BC_Mode temp_bc_mode = LinOp::Homogeneous_BC;
+
+    Real vals[2] = { norm_inf(r, true), Lp.norm(0, lev, true) };
+
+    ParallelDescriptor::ReduceRealMax(vals,2,color());
+
+    Real       rnorm    = vals[0];
+    const Real rnorm0   = rnorm;
+    const Real Lp_norm  = vals[1];
+    Real       sol_norm = 0;
+
+    if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+    {
+        Spacer(std::cout, lev);
+        std::cout << "CGSolver_PipeBiCGStab: Initial error (error0) =        " << rnorm0 << '\n';
+    }
+
+    int ret = 0, nit = 1;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+	{
+            Spacer(std::cout, lev);
+            std::cout << "CGSolver_PipeBiCGStab: niter = 0,"
+                      << ", rnorm = " << rnorm 
+                      << ", eps_abs = " << eps_abs << std::endl;
+	}
+        return ret;
+    }
+
+    precondition(rhat, r, eps_rel, eps_abs);
+    Lp.apply(w, rhat, lev, temp_bc_mode);
+    precondition(what, w, eps_rel, eps_abs);
+    Lp.apply(t, what, lev, temp_bc_mode);
+    //
+    // rho = (rh,r); alpha = rho/(rh,w).
+    //
+    Real dots[4] = { dotxy(rh,r,true), dotxy(rh,w,true), 0, 0 };
+
+    ParallelDescriptor::ReduceRealSum(dots,2,color());
+
+    Real rho = dots[0], alpha = 0, beta = 0, omega = 0;
+
+    if ( rho == 0 || dots[1] == 0 )
+    {
+        ret = 1;
+    }
+    else
+    {
+        alpha = rho/dots[1];
+    }
+
+    for (; ret == 0 && nit <= maxiter; ++nit)
+    {
+        if ( nit == 1 )
+        {
+            MultiFab::Copy(p,r,0,0,1,0);
+            MultiFab::Copy(s,w,0,0,1,0);
+            MultiFab::Copy(z,t,0,0,1,0);
+            if ( precond )
+            {
+                MultiFab::Copy(phat,rhat,0,0,1,0);
+                MultiFab::Copy(shat,what,0,0,1,0);
+            }
+        }
+        else
+        {
+            //
+            // x = x_1 + beta*(x_1 - omega*y_1)
+            //
+            sxay(p, p, -omega, s);
+            sxay(p, r,   beta, p);
+            if ( precond )
+            {
+                sxay(phat, phat, -omega, shat);
+                sxay(phat, rhat,   beta, phat);
+                sxay(shat, shat, -omega, zhat);
+                sxay(shat, what,   beta, shat);
+            }
+            sxay(s, s, -omega, z);
+            sxay(s, w,   beta, s);
+            sxay(z, z, -omega, v);
+            sxay(z, t,   beta, z);
+        }
+        //
+        // q = r - alpha*s; y = w - alpha*z
+        //
+        sxay(q, r, -alpha, s);
+        sxay(y, w, -alpha, z);
+
+        Real qy[2] = { dotxy(q,y,true), dotxy(y,y,true) };
+
+        ParallelDescriptor::Message qy_msg = ParallelDescriptor::IReduceRealSum(qy,2,color());
+
+        precondition(zhat, z, eps_rel, eps_abs);
+        Lp.apply(v, zhat, lev, temp_bc_mode);
+
+        qy_msg.wait();
+
+        if ( qy[1] == 0 )
+        {
+            ret = 3; break;
+        }
+
+        omega = qy[0]/qy[1];
+
+        sxay(sol, sol, alpha, phat);
+        //
+        // The preconditioned q is rhat - alpha*shat.
+        //
+        if ( precond )
+        {
+            sxay(rhat, rhat, -alpha, shat);
+            sxay(sol,  sol,   omega, rhat);
+            //
+            // rhat = q^ - omega*(what - alpha*zhat)
+            //
+            sxay(rhat, rhat, -omega, what);
+            sxay(rhat, rhat, alpha*omega, zhat);
+        }
+        else
+        {
+            sxay(sol, sol, omega, q);
+        }
+        //
+        // r = q - omega*y; w = y - omega*(t - alpha*v)
+        //
+        sxay(r, q, -omega, y);
+        sxay(w, y, -omega, t);
+        sxay(w, w, alpha*omega, v);
+        //
+        // (rh,r), (rh,w), (rh,s), (rh,z), and the norms of r and sol.
+        //
+        dots[0] = dotxy(rh,r,true);
+        dots[1] = dotxy(rh,w,true);
+        dots[2] = dotxy(rh,s,true);
+        dots[3] = dotxy(rh,z,true);
+
+        Real maxs[2] = { norm_inf(r,true), norm_inf(sol,true) };
+
+        ParallelDescriptor::Message sum_msg = ParallelDescriptor::IReduceRealSum(dots,4,color());
+        ParallelDescriptor::Message max_msg = ParallelDescriptor::IReduceRealMax(maxs,2,color());
+
+        precondition(what, w, eps_rel, eps_abs);
+        Lp.apply(t, what, lev, temp_bc_mode);
+
+        sum_msg.wait();
+        max_msg.wait();
+
+        rnorm    = maxs[0];
+        sol_norm = maxs[1];
+
+        if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
+        {
+            Spacer(std::cout, lev);
+            std::cout << "CGSolver_PipeBiCGStab: Iteration "
+                      << std::setw(11) << nit
+                      << " rel. err. "
+                      << rnorm/(rnorm0) << '\n';
+        }
+
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+        if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+#else
+        if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
+#endif
+        if ( omega == 0 )
+        {
+            ret = 4; break;
+        }
+
+        const Real rho_1 = rho;
+
+        rho = dots[0];
+
+        if ( rho == 0 )
+        {
+            ret = 1; break;
+        }
+
+        beta = (rho/rho_1)*(alpha/omega);
+
+        const Real denom = dots[1] + beta*dots[2] - beta*omega*dots[3];
+
+        if ( denom == 0 )
+        {
+            ret = 2; break;
+        }
+
+        alpha = rho/denom;
+    }
+
+    if ( verbose > 0 && ParallelDescriptor::IOProcessor(color()) )
+    {
+        Spacer(std::cout, lev);
+        std::cout << "CGSolver_PipeBiCGStab: Final: Iteration "
+                  << std::setw(4) << nit
+                  << " rel. err. "
+                  << rnorm/(rnorm0) << '\n';
+    }
+
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+    if ( ret == 0 && rnorm > eps_rel*rnorm0 && rnorm > eps_abs)
+#else
+    if ( ret == 0 && rnorm > eps_rel*(Lp_norm*sol_norm + rnorm0 ) && rnorm > eps_abs )
+#endif
+    {
+        if ( ParallelDescriptor::IOProcessor(color()) )
+            BoxLib::Warning("CGSolver_PipeBiCGStab:: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, 1, 0);
+    } 
+    else 
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, 1, 0);
+    }
+
+    return ret;
+}
+
 int
 CGSolver::solve_cg (MultiFab&       sol,
 		    const MultiFab& rhs,
@@ -1161,8 +1777,7 @@ CGSolver::solve_cg (MultiFab&       sol,
         }
         sxay(sol, sol, alpha, p);
         sxay(  r,   r,-alpha, q);
-        rnorm = norm_inf(r);
-        sol_norm = norm_inf(sol);
+        norm_inf(r, rnorm, sol, sol_norm);
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
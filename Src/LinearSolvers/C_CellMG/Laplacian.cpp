@@ -241,3 +241,20 @@ Laplacian::Fapply (MultiFab&       y,
                    h[level]);
     }
 }
+
+void
+Laplacian::FapplyTile (FArrayBox&       yfab,
+                       const FArrayBox& xfab,
+                       const Box&       tbx,
+                       int              gridno,
+                       int              level)
+{
+    const int num_comp = 1;
+
+    FORT_ADOTX(yfab.dataPtr(), 
+               ARLIM(yfab.loVect()), ARLIM(yfab.hiVect()),
+               xfab.dataPtr(), 
+               ARLIM(xfab.loVect()), ARLIM(xfab.hiVect()),
+               tbx.loVect(), tbx.hiVect(), &num_comp,
+               h[level]);
+}
@@ -190,6 +190,29 @@ LinOp::applyBC (MultiFab&      inout,
     BL_ASSERT(level < numLevels());
     BL_ASSERT(!(level > 0 && bc_mode == Inhomogeneous_BC));
 
+    prepareForLevel(level);
+
+    const bool cross = true;
+    inout.FillBoundary(src_comp,num_comp,geomarray[level].periodicity(),cross);
+
+    applyPhysBC(inout, src_comp, num_comp, level, bc_mode, local, bndry_comp);
+}
+
+void
+LinOp::applyPhysBC (MultiFab&      inout,
+                    int            src_comp,
+                    int            num_comp,
+                    int            level,
+                    LinOp::BC_Mode bc_mode,
+                    bool           local,
+                    int            bndry_comp)
+{
+    BL_PROFILE("LinOp::applyPhysBC()");
+
+    BL_ASSERT(inout.nGrow() >= LinOp_grow);
+    BL_ASSERT(level < numLevels());
+    BL_ASSERT(!(level > 0 && bc_mode == Inhomogeneous_BC));
+
     int flagden = 1; // Fill in undrrelxr.
     int flagbc  = 1; // Fill boundary data.
 
@@ -198,12 +221,6 @@ LinOp::applyBC (MultiFab&      inout,
         // No data if homogeneous.
         //
         flagbc = 0;
-
-    prepareForLevel(level);
-
-    const bool cross = true;
-    inout.FillBoundary(src_comp,num_comp,geomarray[level].periodicity(),cross);
-
     //
     // Fill boundary cells.
     //
@@ -283,6 +300,18 @@ LinOp::smooth (MultiFab&       solnL,
     }
 }
 
+void
+LinOp::smoothDeepHalo (MultiFab&       solnL,
+                       const MultiFab& rhsL,
+                       int             level,
+                       LinOp::BC_Mode  bc_mode,
+                       int             nsmooth,
+                       int             depth)
+{
+    for (int i = 0; i < nsmooth; i++)
+        smooth(solnL, rhsL, level, bc_mode);
+}
+
 void
 LinOp::jacobi_smooth (MultiFab&       solnL,
                       const MultiFab& rhsL,
@@ -293,6 +322,104 @@ LinOp::jacobi_smooth (MultiFab&       solnL,
     Fsmooth_jacobi(solnL, rhsL, level);
 }
 
+void
+LinOp::FapplyTile (FArrayBox&       out,
+                   const FArrayBox& in,
+                   const Box&       tbx,
+                   int              gridno,
+                   int              level)
+{
+    BoxLib::Abort("LinOp::FapplyTile: not implemented for this operator");
+}
+
+void
+LinOp::smoothSP (FloatMultiFab&       solnL,
+                 const FloatMultiFab& rhsL,
+                 int                  level)
+{
+    BoxLib::Abort("LinOp::smoothSP: not implemented for this operator");
+}
+
+void
+LinOp::residualSP (FloatMultiFab&       residL,
+                   const FloatMultiFab& rhsL,
+                   FloatMultiFab&       solnL,
+                   int                  level)
+{
+    BoxLib::Abort("LinOp::residualSP: not implemented for this operator");
+}
+
+Real
+LinOp::homogeneousBndryCoef (int         gridno,
+                             Orientation face,
+                             int         level) const
+{
+    const int  bct = bgb->bndryConds(gridno)[face][0];
+    const Real bcl = bgb->bndryLocs(gridno)[face];
+
+    if (bct == LO_NEUMANN)
+        return 1;
+
+    if (bct == LO_REFLECT_ODD)
+        return -1;
+
+    if (bct != LO_DIRICHLET)
+        BoxLib::Abort("LinOp::homogeneousBndryCoef: unknown boundary condition");
+    //
+    // The coefficient of the outermost valid cell center (at 0.5) in the
+    // linear interpolant through the boundary location, evaluated at the
+    // ghost cell center (at -0.5), exactly as polyInterpCoeff computes it.
+    //
+    const Real xInt = -0.5;
+    const Real xbnd = -bcl/h[level][face.coordDir()];
+    const Real x0   =  0.5;
+
+    return (xInt - xbnd)/(x0 - xbnd);
+}
+
+void
+LinOp::applyBCSP (FloatMultiFab& solnL,
+                  int            level)
+{
+    BL_PROFILE("LinOp::applyBCSP()");
+
+    BL_ASSERT(solnL.nGrow() >= LinOp_grow);
+    BL_ASSERT(level < numLevels());
+    BL_ASSERT(maxorder == 2);
+
+    const bool cross = true;
+    solnL.FillBoundary(geomarray[level].periodicity(),cross);
+    //
+    // With homogeneous data the second order interpolant makes each masked
+    // ghost cell a multiple of its valid neighbor; see FORT_APPLYBC.
+    //
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(solnL); mfi.isValid(); ++mfi)
+    {
+        const int        gn  = mfi.index();
+        const Box&       vbx = mfi.validbox();
+        BaseFab<float>&  fab = solnL[mfi];
+
+        for (OrientationIter oitr; oitr; ++oitr)
+        {
+            const Orientation face = oitr();
+            const Mask&       m    = maskvals[level][face][mfi];
+            const float       c    = homogeneousBndryCoef(gn, face, level);
+            const Box         gbx  = BoxLib::adjCell(vbx, face);
+            const IntVect     in   = face.isLow() ?  BoxLib::BASISV(face.coordDir())
+                                                  : -BoxLib::BASISV(face.coordDir());
+
+            for (IntVect iv = gbx.smallEnd(); iv <= gbx.bigEnd(); gbx.next(iv))
+            {
+                if (m(iv) > 0)
+                    fab(iv) = c*fab(iv+in);
+            }
+        }
+    }
+}
+
 Real
 LinOp::norm (int nm, int level, const bool local)
 {
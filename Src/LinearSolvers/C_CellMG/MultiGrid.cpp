@@ -2,11 +2,13 @@
 #include <winstd.H>
 #include <algorithm>
 #include <cstdlib>
+#include <limits>
 
 #include <ParmParse.H>
 #include <Utility.H>
 #include <ParallelDescriptor.H>
 #include <CGSolver.H>
+#include <ABecLaplacian.H>
 #include <MG_F.H>
 #include <MultiGrid.H>
 
@@ -30,6 +32,11 @@ int              MultiGrid::def_maxiter;
 int              MultiGrid::def_maxiter_b;
 int              MultiGrid::def_numLevelsMAX;
 int              MultiGrid::def_smooth_on_cg_unstable;
+int              MultiGrid::def_agglomerate;
+int              MultiGrid::def_agg_grid_size;
+int              MultiGrid::def_fuse_transfer;
+int              MultiGrid::def_halo_depth;
+int              MultiGrid::def_mixed_precision;
 int              MultiGrid::use_Anorm_for_convergence;
 
 void
@@ -56,6 +63,11 @@ MultiGrid::Initialize ()
     MultiGrid::def_maxiter_b             = 120;
     MultiGrid::def_numLevelsMAX          = 1024;
     MultiGrid::def_smooth_on_cg_unstable = 1;
+    MultiGrid::def_agglomerate           = 0;
+    MultiGrid::def_agg_grid_size         = 32;
+    MultiGrid::def_fuse_transfer         = 1;
+    MultiGrid::def_halo_depth            = 1;
+    MultiGrid::def_mixed_precision       = 0;
 
     // This has traditionally been part of the stopping criteria, but for testing against
     //  other solvers it is convenient to be able to turn it off
@@ -77,6 +89,11 @@ MultiGrid::Initialize ()
     pp.query("maxiter_b",             def_maxiter_b);
     pp.query("numLevelsMAX",          def_numLevelsMAX);
     pp.query("smooth_on_cg_unstable", def_smooth_on_cg_unstable);
+    pp.query("agglomerate",           def_agglomerate);
+    pp.query("agg_grid_size",         def_agg_grid_size);
+    pp.query("fuse_transfer",         def_fuse_transfer);
+    pp.query("halo_depth",            def_halo_depth);
+    pp.query("mixed_precision",       def_mixed_precision);
 
     pp.query("use_Anorm_for_convergence", use_Anorm_for_convergence);
 #ifndef CG_USE_OLD_CONVERGENCE_CRITERIA
@@ -102,6 +119,11 @@ MultiGrid::Initialize ()
         std::cout << "   def_maxiter_b             = " << def_maxiter_b             << '\n';
         std::cout << "   def_numLevelsMAX          = " << def_numLevelsMAX          << '\n';
         std::cout << "   def_smooth_on_cg_unstable = " << def_smooth_on_cg_unstable << '\n';
+        std::cout << "   def_agglomerate           = " << def_agglomerate           << '\n';
+        std::cout << "   def_agg_grid_size         = " << def_agg_grid_size         << '\n';
+        std::cout << "   def_fuse_transfer         = " << def_fuse_transfer         << '\n';
+        std::cout << "   def_halo_depth            = " << def_halo_depth            << '\n';
+        std::cout << "   def_mixed_precision       = " << def_mixed_precision       << '\n';
         std::cout << "   use_Anorm_for_convergence = " << use_Anorm_for_convergence << '\n';
     }
 
@@ -133,9 +155,63 @@ Spacer (std::ostream& os, int lev)
     }
 }
 
+//
+// dst = src, or dst += src if add, on the valid cells, converting between
+// double and single precision.
+//
+template <class DFAB, class SFAB>
+static
+void
+ConvertValid (FabArray<DFAB>&       dst,
+              const FabArray<SFAB>& src,
+              bool                  add)
+{
+    typedef typename DFAB::value_type DT;
+    typedef typename SFAB::value_type ST;
+
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box&  bx   = mfi.tilebox();
+        DFAB&       dfab = dst[mfi];
+        const SFAB& sfab = src[mfi];
+        const int   nx   = bx.length(0);
+
+        Box pencils(bx);
+        pencils.setBig(0, bx.smallEnd(0));
+
+        for (IntVect p = pencils.smallEnd(); p <= pencils.bigEnd(); pencils.next(p))
+        {
+            DT*       d = dfab.dataPtr() + dfab.box().index(p);
+            const ST* q = sfab.dataPtr() + sfab.box().index(p);
+
+            if ( add )
+            {
+                for (int i = 0; i < nx; ++i)
+                    d[i] += q[i];
+            }
+            else
+            {
+                for (int i = 0; i < nx; ++i)
+                    d[i] = q[i];
+            }
+        }
+    }
+}
+
 MultiGrid::MultiGrid (LinOp &_lp)
     :
     initialsolution(0),
+    agg_state(-1),
+    agg_coefs_valid(false),
+    agg_lp(0),
+    agg_mg(0),
+    agg_rhs(0),
+    agg_cor(0),
     Lp(_lp)
 {
     Initialize();
@@ -153,6 +229,11 @@ MultiGrid::MultiGrid (LinOp &_lp)
     nu_b         = def_nu_b;
     numLevelsMAX = def_numLevelsMAX;
     smooth_on_cg_unstable = def_smooth_on_cg_unstable;
+    agglomerate  = def_agglomerate;
+    agg_grid_size = def_agg_grid_size;
+    fuse_transfer = def_fuse_transfer;
+    halo_depth    = def_halo_depth;
+    mixed_precision = def_mixed_precision;
     numlevels    = numLevels();
 
     do_fixed_number_of_iters = 0;
@@ -200,12 +281,24 @@ MultiGrid::~MultiGrid ()
 {
     delete initialsolution;
 
+    delete agg_mg;
+    delete agg_lp;
+    delete agg_rhs;
+    delete agg_cor;
+
     for (int i = 0; i < cor.size(); ++i)
     {
         delete res[i];
         delete rhs[i];
         delete cor[i];
     }
+
+    for (int i = 0; i < cor_sp.size(); ++i)
+    {
+        delete res_sp[i];
+        delete rhs_sp[i];
+        delete cor_sp[i];
+    }
 }
 
 Real
@@ -220,14 +313,20 @@ MultiGrid::errorEstimate (int            level,
 void
 MultiGrid::prepareForLevel (int level)
 {
+    BL_PROFILE("MultiGrid::prepareForLevel()");
     //
     // Build this level by allocating reqd internal MultiFabs if necessary.
     //
-    if ( cor.size() > level ) return;
-
-    res.resize(level+1, (MultiFab*)0);
-    rhs.resize(level+1, (MultiFab*)0);
-    cor.resize(level+1, (MultiFab*)0);
+    if ( cor.size() > level && cor[level] != 0 ) return;
+    //
+    // The mixed-precision cycles only use the finest and the coarsest level.
+    //
+    if ( cor.size() <= level )
+    {
+        res.resize(level+1, (MultiFab*)0);
+        rhs.resize(level+1, (MultiFab*)0);
+        cor.resize(level+1, (MultiFab*)0);
+    }
 
     Lp.prepareForLevel(level);
 
@@ -244,6 +343,32 @@ MultiGrid::prepareForLevel (int level)
     }
 }
 
+void
+MultiGrid::prepareForLevelSP (int level)
+{
+    BL_PROFILE("MultiGrid::prepareForLevelSP()");
+
+    if ( cor_sp.size() > level && cor_sp[level] != 0 ) return;
+
+    if ( cor_sp.size() <= level )
+    {
+        res_sp.resize(level+1, (LinOp::FloatMultiFab*)0);
+        rhs_sp.resize(level+1, (LinOp::FloatMultiFab*)0);
+        cor_sp.resize(level+1, (LinOp::FloatMultiFab*)0);
+    }
+
+    Lp.prepareForLevel(level);
+    //
+    // Same layout as the double precision data of the finest level.
+    //
+    const BoxArray&            ba = Lp.boxArray(level);
+    const DistributionMapping& dm = cor[0]->DistributionMap();
+
+    res_sp[level] = new LinOp::FloatMultiFab(ba, 1, 0, dm);
+    rhs_sp[level] = new LinOp::FloatMultiFab(ba, 1, 0, dm);
+    cor_sp[level] = new LinOp::FloatMultiFab(ba, 1, Lp.NumGrow(), dm);
+}
+
 void
 MultiGrid::solve (MultiFab&       _sol,
                   const MultiFab& _rhs,
@@ -258,6 +383,10 @@ MultiGrid::solve (MultiFab&       _sol,
     //
     const int level = 0;
     prepareForLevel(level);
+    //
+    // The coefficients may have changed since the last solve.
+    //
+    agg_coefs_valid = false;
 
     //
     // Copy the initial guess, which may contain inhomogeneous boundray conditions,
@@ -320,6 +449,15 @@ MultiGrid::solve_ (MultiFab&      _sol,
   const Real strt_time = ParallelDescriptor::second();
 
   const int level = 0;
+  //
+  // In mixed precision every iteration corrects the residual of the
+  // previous one, which starts out as the initial residual.
+  //
+  const bool mixed = mixed_precision && numlevels > 1 && Lp.hasSinglePrecision()
+                  && bc_mode == LinOp::Homogeneous_BC;
+
+  if ( mixed )
+      MultiFab::Copy(*res[level], *rhs[level], 0, 0, 1, 0);
 
   //
   // We take the max of the norms of the initial RHS and the initial residual in order to capture both cases
@@ -381,7 +519,10 @@ MultiGrid::solve_ (MultiFab&      _sol,
              && nit <= maxiter;
            ++nit)
      {
-         relax(*cor[level], *rhs[level], level, eps_rel, eps_abs, bc_mode, cg_time);
+         if ( mixed )
+             relaxMixed(*cor[level], level, eps_rel, eps_abs, cg_time);
+         else
+             relax(*cor[level], *rhs[level], level, eps_rel, eps_abs, bc_mode, cg_time);
 
          Real tmp[2] = { norm_inf(*cor[level],true), errorEstimate(level,bc_mode,true) };
 
@@ -430,7 +571,10 @@ MultiGrid::solve_ (MultiFab&      _sol,
              && nit <= maxiter;
            ++nit)
      {
-         relax(*cor[level], *rhs[level], level, eps_rel, eps_abs, bc_mode, cg_time);
+         if ( mixed )
+             relaxMixed(*cor[level], level, eps_rel, eps_abs, cg_time);
+         else
+             relax(*cor[level], *rhs[level], level, eps_rel, eps_abs, bc_mode, cg_time);
 
          error = errorEstimate(level, bc_mode);
 	
@@ -596,11 +740,18 @@ MultiGrid::relax (MultiFab&      solL,
               std::cout << "    DN:Norm before smooth " << rnorm << '\n';;
            }
         }
-        for (int i = preSmooth() ; i > 0 ; i--)
+        smoothLevel(solL, rhsL, level, preSmooth(), bc_mode);
+        const bool fused = fuse_transfer && Lp.hasTileApply();
+
+        if ( fused )
+        {
+            prepareForLevel(level+1);
+            residualAverage(*rhs[level+1], *cor[level+1], *res[level], rhsL, solL, level, bc_mode);
+        }
+        else
         {
-            Lp.smooth(solL, rhsL, level, bc_mode);
+            Lp.residual(*res[level], rhsL, solL, level, bc_mode);
         }
-        Lp.residual(*res[level], rhsL, solL, level, bc_mode);
 
         if ( verbose > 2 )
         {
@@ -609,9 +760,12 @@ MultiGrid::relax (MultiFab&      solL,
               std::cout << "    DN:Norm after  smooth " << rnorm << '\n';
         }
 
-        prepareForLevel(level+1);
-        average(*rhs[level+1], *res[level]);
-        cor[level+1]->setVal(0.0);
+        if ( !fused )
+        {
+            prepareForLevel(level+1);
+            average(*rhs[level+1], *res[level]);
+            cor[level+1]->setVal(0.0);
+        }
         for (int i = cntRelax(); i > 0 ; i--)
         {
             relax(*cor[level+1],*rhs[level+1],level+1,eps_rel,eps_abs,bc_mode,cg_time);
@@ -629,10 +783,7 @@ MultiGrid::relax (MultiFab&      solL,
            }
         }
 
-        for (int i = postSmooth(); i > 0 ; i--)
-        {
-            Lp.smooth(solL, rhsL, level, bc_mode);
-        }
+        smoothLevel(solL, rhsL, level, postSmooth(), bc_mode);
         if ( verbose > 2 )
         {
            Lp.residual(*res[level], rhsL, solL, level, bc_mode);
@@ -665,6 +816,80 @@ MultiGrid::relax (MultiFab&      solL,
     }
 }
 
+void
+MultiGrid::relaxMixed (MultiFab&      solL,
+                       int            level,
+                       Real           eps_rel,
+                       Real           eps_abs,
+                       Real&          cg_time)
+{
+    BL_PROFILE("MultiGrid::relaxMixed()");
+    //
+    // One step of iterative refinement: res[level] holds the double
+    // precision residual of solL, whose correction is found in float.
+    //
+    prepareForLevelSP(level);
+
+    ConvertValid(*rhs_sp[level], *res[level], false);
+    cor_sp[level]->setVal(0);
+
+    relaxSP(level, eps_rel, eps_abs, cg_time);
+
+    ConvertValid(solL, *cor_sp[level], true);
+}
+
+void
+MultiGrid::relaxSP (int            level,
+                    Real           eps_rel,
+                    Real           eps_abs,
+                    Real&          cg_time)
+{
+    BL_PROFILE("MultiGrid::relaxSP()");
+
+    LinOp::FloatMultiFab& solL = *cor_sp[level];
+    LinOp::FloatMultiFab& rhsL = *rhs_sp[level];
+
+    if ( level < numlevels - 1 )
+    {
+        for (int i = preSmooth(); i > 0; i--)
+        {
+            Lp.smoothSP(solL, rhsL, level);
+        }
+
+        Lp.residualSP(*res_sp[level], rhsL, solL, level);
+
+        prepareForLevelSP(level+1);
+        averageSP(*rhs_sp[level+1], *res_sp[level]);
+        cor_sp[level+1]->setVal(0);
+
+        for (int i = cntRelax(); i > 0 ; i--)
+        {
+            relaxSP(level+1, eps_rel, eps_abs, cg_time);
+        }
+        interpolateSP(solL, *cor_sp[level+1]);
+
+        for (int i = postSmooth(); i > 0; i--)
+        {
+            Lp.smoothSP(solL, rhsL, level);
+        }
+    }
+    else
+    {
+        //
+        // The bottom problem is small, solve it in double precision.
+        //
+        prepareForLevel(level);
+
+        ConvertValid(*rhs[level], rhsL, false);
+        cor[level]->setVal(0.0);
+
+        coarsestSmooth(*cor[level], *rhs[level], level, eps_rel, eps_abs,
+                       LinOp::Homogeneous_BC, usecg, cg_time);
+
+        ConvertValid(solL, *cor[level], false);
+    }
+}
+
 void
 MultiGrid::coarsestSmooth (MultiFab&      solL,
                            MultiFab&      rhsL,
@@ -678,6 +903,9 @@ MultiGrid::coarsestSmooth (MultiFab&      solL,
     BL_PROFILE("MultiGrid::coarsestSmooth()");
     prepareForLevel(level);
 
+    if ( agglomerate && agglomeratedSmooth(solL, rhsL, level, bc_mode, cg_time) )
+        return;
+
     if ( local_usecg == 0 )
     {
         Real error0 = 0;
@@ -689,19 +917,26 @@ MultiGrid::coarsestSmooth (MultiFab&      solL,
                           << error0 << '\n';
         }
 
-        for (int i = finalSmooth(); i > 0; i--)
+        if ( verbose == 0 )
         {
-            Lp.smooth(solL, rhsL, level, bc_mode);
-
-            if ( verbose > 1 || (i == 1 && verbose) )
+            smoothLevel(solL, rhsL, level, finalSmooth(), bc_mode);
+        }
+        else
+        {
+            for (int i = finalSmooth(); i > 0; i--)
             {
-                Real error = errorEstimate(level, bc_mode);
-                const Real rel_error = (error0 != 0) ? error/error0 : 0;
-                if ( ParallelDescriptor::IOProcessor(color()) )
-                    std::cout << "   Bottom Smoother: Iteration "
-                              << i
-                              << " error/error0 = "
-                              << rel_error << '\n';
+                Lp.smooth(solL, rhsL, level, bc_mode);
+
+                if ( verbose > 1 || (i == 1 && verbose) )
+                {
+                    Real error = errorEstimate(level, bc_mode);
+                    const Real rel_error = (error0 != 0) ? error/error0 : 0;
+                    if ( ParallelDescriptor::IOProcessor(color()) )
+                        std::cout << "   Bottom Smoother: Iteration "
+                                  << i
+                                  << " error/error0 = "
+                                  << rel_error << '\n';
+                }
             }
         }
     }
@@ -748,11 +983,204 @@ MultiGrid::coarsestSmooth (MultiFab&      solL,
                 }
             }
 	}
-        for (int i = 0; i < nu_b; i++)
+        smoothLevel(solL, rhsL, level, nu_b, bc_mode);
+    }
+}
+
+bool
+MultiGrid::buildAgglomeration (int level)
+{
+    BL_PROFILE("MultiGrid::buildAgglomeration()");
+
+    agg_state = 0;
+
+    ABecLaplacian* abec = dynamic_cast<ABecLaplacian*>(&Lp);
+
+    if ( abec == 0 ) return false;
+
+    const BoxArray& ba     = Lp.boxArray(level);
+    const Geometry& geom   = Lp.getGeom(level);
+    const Box&      domain = geom.Domain();
+    //
+    // Only a level covering the whole domain is agglomerated, so that the
+    // merged boxes see nothing but physical and periodic boundaries.
+    //
+    if ( !ba.contains(domain) ) return false;
+
+    BoxArray aba(domain);
+    aba.maxSize(agg_grid_size);
+
+    if ( aba.size() >= ba.size() ) return false;
+    //
+    // The boundary conditions must be the same along each face of the domain.
+    // Gather max(bct), max(-bct), max(bcl) and max(-bcl) for each face in one reduction.
+    //
+    const int NF = 2*BL_SPACEDIM;
+
+    Array<Real> vals(4*NF, -std::numeric_limits<Real>::max());
+
+    const BndryData& bd = Lp.bndryData();
+
+    for (MFIter mfi(*rhs[level]); mfi.isValid(); ++mfi)
+    {
+        const Box&                       bx  = mfi.validbox();
+        const Array< Array<BoundCond> >& bdc = bd.bndryConds(mfi.index());
+        const BndryData::RealTuple&      bdl = bd.bndryLocs(mfi.index());
+
+        for (OrientationIter oitr; oitr; ++oitr)
         {
-            Lp.smooth(solL, rhsL, level, bc_mode);
+            const Orientation o   = oitr();
+            const int         dir = o.coordDir();
+
+            if ( o.isLow() ? (bx.smallEnd(dir) != domain.smallEnd(dir))
+                           : (bx.bigEnd(dir)   != domain.bigEnd(dir)) )
+                continue;
+
+            const Real bct = int(bdc[o][0]);
+
+            vals[4*o+0] = std::max(vals[4*o+0],  bct);
+            vals[4*o+1] = std::max(vals[4*o+1], -bct);
+            vals[4*o+2] = std::max(vals[4*o+2],  bdl[o]);
+            vals[4*o+3] = std::max(vals[4*o+3], -bdl[o]);
+        }
+    }
+
+    ParallelDescriptor::ReduceRealMax(vals.dataPtr(), vals.size(), color());
+
+    for (OrientationIter oitr; oitr; ++oitr)
+    {
+        const Orientation o = oitr();
+
+        if ( vals[4*o] < 0 ) return false;
+
+        if ( !geom.isPeriodic(o.coordDir()) &&
+             (vals[4*o] != -vals[4*o+1] || vals[4*o+2] != -vals[4*o+3]) )
+            return false;
+    }
+    //
+    // With several communicator colors put the agglomerated problem on the
+    // first sub-communicator.  The right-hand side and correction are needed
+    // on all processors for the copies; the rest only where it is active.
+    //
+    ParallelDescriptor::Color clr = color();
+
+    if ( ParallelDescriptor::NColors() > 1 && clr == ParallelDescriptor::DefaultColor() )
+        clr = ParallelDescriptor::Color(0);
+
+    agg_rhs = new MultiFab(aba, 1, Lp.NumGrow(), clr);
+    agg_cor = new MultiFab(aba, 1, Lp.NumGrow(), clr);
+
+    if ( ParallelDescriptor::isActive(clr) )
+    {
+        BndryData* abd = new BndryData(aba, 1, geom, clr);
+
+        for (OrientationIter oitr; oitr; ++oitr)
+        {
+            const Orientation o = oitr();
+
+            (*abd)[o].setVal(0);
+
+            for (FabSetIter bfsi((*abd)[o]); bfsi.isValid(); ++bfsi)
+            {
+                abd->setBoundCond(o, bfsi.index(), 0, BoundCond(int(vals[4*o])));
+                abd->setBoundLoc(o, bfsi.index(), vals[4*o+2]);
+            }
         }
+
+        agg_lp = new ABecLaplacian(abd, Lp.getDx(level));
+        agg_lp->maxOrder(Lp.maxOrder());
+        agg_lp->setScalars(abec->get_alpha(), abec->get_beta());
+
+        agg_mg = new MultiGrid(*agg_lp);
+        agg_mg->setAgglomerate(0);
+        agg_mg->setVerbose(verbose > 2 ? verbose-2 : 0);
+        agg_mg->setUseCG(usecg);
+        agg_mg->set_preSmooth(preSmooth());
+        agg_mg->set_postSmooth(postSmooth());
+        agg_mg->set_finalSmooth(finalSmooth());
+        agg_mg->set_rtol_b(rtol_b);
+        agg_mg->set_atol_b(atol_b);
+        agg_mg->set_maxiter_b(maxiter_b);
+        agg_mg->prepareForLevel(0);
+    }
+
+    if ( ParallelDescriptor::IOProcessor(color()) && verbose > 0 )
+        std::cout << "MultiGrid: agglomerating " << ba.size() << " boxes at level "
+                  << level << " into " << aba.size() << " boxes\n";
+
+    agg_state       = 1;
+    agg_coefs_valid = false;
+
+    return true;
+}
+
+bool
+MultiGrid::agglomeratedSmooth (MultiFab&      solL,
+                               MultiFab&      rhsL,
+                               int            level,
+                               LinOp::BC_Mode bc_mode,
+                               Real&          cg_time)
+{
+    if ( bc_mode != LinOp::Homogeneous_BC ) return false;
+
+    if ( agg_state < 0 ) buildAgglomeration(level);
+
+    if ( agg_state == 0 ) return false;
+
+    BL_PROFILE("MultiGrid::agglomeratedSmooth()");
+
+    const BoxArray&                 aba = agg_rhs->boxArray();
+    const ParallelDescriptor::Color clr = agg_rhs->color();
+
+    if ( !agg_coefs_valid )
+    {
+        MultiFab             a(aba, 1, 0, clr);
+        PArray<MultiFab>     b(BL_SPACEDIM, PArrayManage);
+
+        a.copy(Lp.aCoefficients(level));
+
+        for (int dir = 0; dir < BL_SPACEDIM; ++dir)
+        {
+            BoxArray eba(aba);
+            eba.surroundingNodes(dir);
+            b.set(dir, new MultiFab(eba, 1, 0, clr));
+            b[dir].copy(Lp.bCoefficients(dir,level));
+        }
+
+        if ( agg_lp != 0 ) agg_lp->setCoefficients(a, b);
+
+        agg_coefs_valid = true;
+    }
+
+    agg_rhs->copy(rhsL);
+    agg_cor->setVal(0.0);
+
+    if ( agg_mg != 0 )
+    {
+        MultiFab& ares = *agg_mg->res[0];
+
+        const Real bnorm = norm_inf(*agg_rhs);
+        Real       error = bnorm;
+        int        nit   = 0;
+
+        while ( nit < maxiter_b && error > rtol_b*bnorm && error > atol_b )
+        {
+            agg_mg->relax(*agg_cor, *agg_rhs, 0, rtol_b, atol_b, LinOp::Homogeneous_BC, cg_time);
+            agg_lp->residual(ares, *agg_rhs, *agg_cor, 0, LinOp::Homogeneous_BC);
+            error = norm_inf(ares);
+            ++nit;
+        }
+
+        if ( ParallelDescriptor::IOProcessor(clr) && verbose > 1 )
+            std::cout << "   Agglomerated bottom: " << nit << " cycles, error/error0 = "
+                      << ((bnorm != 0) ? error/bnorm : 0) << '\n';
     }
+
+    solL.copy(*agg_cor);
+
+    smoothLevel(solL, rhsL, level, nu_b, bc_mode);
+
+    return true;
 }
 
 void
@@ -784,6 +1212,74 @@ MultiGrid::average (MultiFab&       c,
     }
 }
 
+void
+MultiGrid::residualAverage (MultiFab&       crhs,
+                            MultiFab&       ccor,
+                            MultiFab&       res,
+                            const MultiFab& rhsL,
+                            MultiFab&       solL,
+                            int             level,
+                            LinOp::BC_Mode  bc_mode)
+{
+    BL_PROFILE("MultiGrid::residualAverage()");
+    //
+    // Fill the ghost cells once, then for each coarse tile apply the operator
+    // on the covered fine cells, form the residual there and average it down
+    // while the fine tile is still in cache.  The arithmetic is the same as
+    // LinOp::residual() followed by average().
+    //
+    Lp.applyBC(solL, 0, 1, level, bc_mode);
+
+    const int  nc     = 1;
+    const bool tiling = true;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter cmfi(crhs,tiling); cmfi.isValid(); ++cmfi)
+    {
+        const int        gn   = cmfi.index();
+        const Box&       cbx  = cmfi.tilebox();
+        const Box&       fbx  = BoxLib::refine(cbx,2);
+        FArrayBox&       cfab = crhs[cmfi];
+        FArrayBox&       rfab = res[cmfi];
+
+        BL_ASSERT(BoxLib::refine(crhs.boxArray()[gn],2) == res.boxArray()[gn]);
+
+        Lp.FapplyTile(rfab, solL[cmfi], fbx, gn, level);
+
+        rfab.mult(-1.0, fbx, 0, nc);
+        rfab.plus(rhsL[cmfi], fbx, fbx, 0, 0, nc);
+
+        FORT_AVERAGE(cfab.dataPtr(),
+                     ARLIM(cfab.loVect()), ARLIM(cfab.hiVect()),
+                     rfab.dataPtr(),
+                     ARLIM(rfab.loVect()), ARLIM(rfab.hiVect()),
+                     cbx.loVect(), cbx.hiVect(), &nc);
+
+        ccor[cmfi].setVal(0.0, cmfi.growntilebox(), 0, nc);
+    }
+}
+
+void
+MultiGrid::smoothLevel (MultiFab&       solL,
+                        const MultiFab& rhsL,
+                        int             level,
+                        int             nsmooth,
+                        LinOp::BC_Mode  bc_mode)
+{
+    if ( halo_depth > 1 && Lp.hasDeepHaloSmooth() )
+    {
+        Lp.smoothDeepHalo(solL, rhsL, level, bc_mode, nsmooth, halo_depth);
+    }
+    else
+    {
+        for (int i = 0; i < nsmooth; i++)
+        {
+            Lp.smooth(solL, rhsL, level, bc_mode);
+        }
+    }
+}
+
 void
 MultiGrid::interpolate (MultiFab&       f,
                         const MultiFab& c)
@@ -811,6 +1307,55 @@ MultiGrid::interpolate (MultiFab&       f,
     }
 }
 
+void
+MultiGrid::averageSP (LinOp::FloatMultiFab&       c,
+                      const LinOp::FloatMultiFab& f)
+{
+    BL_PROFILE("MultiGrid::averageSP()");
+
+    const bool tiling = true;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter cmfi(c,tiling); cmfi.isValid(); ++cmfi)
+    {
+        const Box&            bx   = cmfi.tilebox();
+        BaseFab<float>&       cfab = c[cmfi];
+        const BaseFab<float>& ffab = f[cmfi];
+
+        FORT_AVERAGE_SP(cfab.dataPtr(),
+                        ARLIM(cfab.loVect()), ARLIM(cfab.hiVect()),
+                        ffab.dataPtr(),
+                        ARLIM(ffab.loVect()), ARLIM(ffab.hiVect()),
+                        bx.loVect(), bx.hiVect());
+    }
+}
+
+void
+MultiGrid::interpolateSP (LinOp::FloatMultiFab&       f,
+                          const LinOp::FloatMultiFab& c)
+{
+    BL_PROFILE("MultiGrid::interpolateSP()");
+    //
+    // Like interpolate(), adds the interpolated c to f.
+    //
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(c,true); mfi.isValid(); ++mfi)
+    {
+        const Box&            bx   = mfi.tilebox();
+        const BaseFab<float>& cfab = c[mfi];
+        BaseFab<float>&       ffab = f[mfi];
+
+        FORT_INTERP_SP(ffab.dataPtr(),
+                       ARLIM(ffab.loVect()), ARLIM(ffab.hiVect()),
+                       cfab.dataPtr(),
+                       ARLIM(cfab.loVect()), ARLIM(cfab.hiVect()),
+                       bx.loVect(), bx.hiVect());
+    }
+}
+
 int
 MultiGrid::getNumLevels (int _numlevels)
 {
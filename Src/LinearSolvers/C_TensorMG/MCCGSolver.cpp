@@ -107,6 +107,30 @@ MCCGSolver::norm (const MultiFab& res)
     return restot;
 }
 
+void
+MCCGSolver::norm_and_rho (const MultiFab& r,
+                          Real&           rnorm,
+                          Real&           rho)
+{
+    if (use_mg_precond)
+    {
+        rnorm = norm(r);
+        return;
+    }
+
+    const int ncomp = r.nComp();
+
+    MultiFabReduction red;
+
+    const int i_rnorm = red.addNorm0(r, 0, ncomp);
+    const int i_rho   = red.addDot(r, 0, r, 0, ncomp);
+
+    red.reduce();
+
+    rnorm = red[i_rnorm];
+    rho   = red[i_rho];
+}
+
 void
 MCCGSolver::solve (MultiFab&       sol,
 		   const MultiFab& rhs,
@@ -175,7 +199,12 @@ MCCGSolver::solve (MultiFab&       sol,
     // Set bc_mode=homogeneous.
     //
     MCBC_Mode temp_bc_mode=MCHomogeneous_BC;
-    Real rnorm  = norm(r);
+    //
+    // Without a preconditioner z = r, so rho = (r,r) is reduced along with
+    // the norm of r.
+    //
+    Real rnorm = 0, rho_r = 0;
+    norm_and_rho(r, rnorm, rho_r);
     Real rnorm0 = rnorm;
     Real minrnorm = rnorm;
     int ret = 0; // will return this value if all goes well
@@ -221,7 +250,7 @@ MCCGSolver::solve (MultiFab&       sol,
 	}
 
 	int ncomp = z.nComp();
-	rho = MultiFab::Dot(r, 0, z, 0, ncomp, 0);
+	rho = use_mg_precond ? MultiFab::Dot(r, 0, z, 0, ncomp, 0) : rho_r;
 	
 	if (nit == 0)
 	{
@@ -267,7 +296,7 @@ MCCGSolver::solve (MultiFab&       sol,
         //
 	rhoold = rho;
 	update( sol, alpha, r, p, w );
-	rnorm = norm(r);
+	norm_and_rho(r, rnorm, rho_r);
         if (rnorm > def_unstable_criterion*minrnorm)
         {
             ret = 2;
@@ -12,7 +12,10 @@ FMultiGrid::FMultiGrid (const Geometry & geom,
     m_verbose(0),
     m_geom(m_nlevels),
     m_bndry(0),
-    m_mgt_solver(0)
+    m_mgt_solver(0),
+    m_ncomp(0),
+    m_coeff_version(0),
+    m_solver_coeff_version(-1)
 {
     m_geom[0] = geom;
 
@@ -32,7 +35,10 @@ FMultiGrid::FMultiGrid (const std::vector<Geometry> & geom,
     m_verbose(0),
     m_geom(m_nlevels),
     m_bndry(0),
-    m_mgt_solver(0)
+    m_mgt_solver(0),
+    m_ncomp(0),
+    m_coeff_version(0),
+    m_solver_coeff_version(-1)
 {
     m_geom = geom;
 
@@ -52,7 +58,10 @@ FMultiGrid::FMultiGrid (const PArray<Geometry> & geom,
     m_verbose(0),
     m_geom(m_nlevels),
     m_bndry(0),
-    m_mgt_solver(0)
+    m_mgt_solver(0),
+    m_ncomp(0),
+    m_coeff_version(0),
+    m_solver_coeff_version(-1)
 {
     for (int ilev = 0; ilev < m_nlevels; ++ilev) {
 	m_geom[ilev] = geom[ilev];
@@ -65,7 +74,7 @@ FMultiGrid::FMultiGrid (const PArray<Geometry> & geom,
 void
 FMultiGrid::set_bc (int * mg_bc)
 {
-    BL_ASSERT(!m_bc.initilized);
+    BL_ASSERT(m_bc.initilized || m_bndry == 0);
     m_bc = Boundary(mg_bc);
 }
 
@@ -73,7 +82,7 @@ void
 FMultiGrid::set_bc (int     * mg_bc,
 		    MultiFab& phi)
 {
-    BL_ASSERT(!m_bc.initilized);
+    BL_ASSERT(m_bc.initilized || m_bndry == 0);
 
     m_bc = Boundary(mg_bc, 0, &phi);
 }
@@ -84,7 +93,7 @@ FMultiGrid::set_bc (int     * mg_bc,
 		    MultiFab& phi)
 {
     BL_ASSERT(m_crse_ratio != IntVect::TheZeroVector());
-    BL_ASSERT(!m_bc.initilized);
+    BL_ASSERT(m_bc.initilized || m_bndry == 0);
 
     m_bc = Boundary(mg_bc, &crse_phi, &phi);
 }
@@ -92,27 +101,29 @@ FMultiGrid::set_bc (int     * mg_bc,
 void
 FMultiGrid::set_bc (const MacBndry& mac_bndry)
 {
-    BL_ASSERT(m_bndry == 0);
+    BL_ASSERT(!m_bc.initilized);
     m_bndry = const_cast<MacBndry*>(&mac_bndry);
 }
 
 void 
 FMultiGrid::set_const_gravity_coeffs ()
 {
-    BL_ASSERT(m_coeff.eq_type == invalid_eq);
+    BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == const_gravity_eq);
 
     m_coeff.eq_type = const_gravity_eq;
+    ++m_coeff_version;
 }
 
 void 
 FMultiGrid::set_gravity_coeffs (PArray<MultiFab>& b)
 {
-    BL_ASSERT(m_coeff.eq_type == invalid_eq);
+    BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == gravity_eq);
     BL_ASSERT(m_nlevels == 1);
     BL_ASSERT(b.size() == BL_SPACEDIM);
 
     m_coeff.eq_type = gravity_eq;
     m_coeff.coeffs_set = true;
+    ++m_coeff_version;
 
     Copy(m_coeff.b, b);
 }
@@ -120,12 +131,13 @@ FMultiGrid::set_gravity_coeffs (PArray<MultiFab>& b)
 void 
 FMultiGrid::set_gravity_coeffs (Array< PArray<MultiFab> >& b)
 {
-    BL_ASSERT(m_coeff.eq_type == invalid_eq);
+    BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == gravity_eq);
     BL_ASSERT(b.size() == m_nlevels);
     BL_ASSERT(b[0].size() == BL_SPACEDIM);
 
     m_coeff.eq_type = gravity_eq;
     m_coeff.coeffs_set = true;
+    ++m_coeff_version;
 
     Copy(m_coeff.b, b);
 }
@@ -133,12 +145,13 @@ FMultiGrid::set_gravity_coeffs (Array< PArray<MultiFab> >& b)
 void 
 FMultiGrid::set_mac_coeffs (PArray<MultiFab>& b)
 {
-    BL_ASSERT(m_coeff.eq_type == invalid_eq);
+    BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == macproj_eq);
     BL_ASSERT(m_nlevels == 1);
     BL_ASSERT(b.size() == BL_SPACEDIM);
 
     m_coeff.eq_type = macproj_eq;
     m_coeff.coeffs_set = true;
+    ++m_coeff_version;
 
     Copy(m_coeff.b, b);
 }
@@ -147,10 +160,10 @@ void
 FMultiGrid::set_scalars (Real alpha, Real beta)
 {
     BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == general_eq);
-    BL_ASSERT(!m_coeff.scalars_set);
     
     m_coeff.eq_type = general_eq;
     m_coeff.scalars_set = true;
+    ++m_coeff_version;
 
     m_coeff.alpha = alpha;
     m_coeff.beta = beta;
@@ -160,11 +173,11 @@ void
 FMultiGrid::set_coefficients (const MultiFab& a, PArray<MultiFab> & b)
 {
     BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == general_eq);
-    BL_ASSERT(!m_coeff.coeffs_set);
     BL_ASSERT(m_nlevels == 1);
     
     m_coeff.eq_type = general_eq;
     m_coeff.coeffs_set   = true;
+    ++m_coeff_version;
 
     Copy(m_coeff.a, a);
     Copy(m_coeff.b, b);
@@ -174,12 +187,12 @@ void
 FMultiGrid::set_coefficients (PArray<MultiFab>& a, Array<PArray<MultiFab> > & b)
 {
     BL_ASSERT(m_coeff.eq_type == invalid_eq || m_coeff.eq_type == general_eq);
-    BL_ASSERT(!m_coeff.coeffs_set);
     BL_ASSERT(m_nlevels == a.size() && m_nlevels == b.size());
     BL_ASSERT(BL_SPACEDIM == b[0].size());
     
     m_coeff.eq_type = general_eq;
     m_coeff.coeffs_set   = true;
+    ++m_coeff_version;
 
     Copy(m_coeff.a, a);
     Copy(m_coeff.b, b);
@@ -210,9 +223,8 @@ FMultiGrid::solve (PArray<MultiFab>& phi,
 		   int verbose)
 {
     BL_ASSERT(  m_bc.initilized || m_bndry != 0);
-    BL_ASSERT(!(m_bc.initilized && m_bndry != 0));
+    BL_ASSERT(!(m_bc.initilized && m_bndry != 0 && !RAII_bndry.defined(0)));
     BL_ASSERT(m_coeff.eq_type != invalid_eq);
-    BL_ASSERT(m_mgt_solver == 0);
 
     MultiFab* phi_p[m_nlevels];
     MultiFab* rhs_p[m_nlevels];
@@ -227,6 +239,9 @@ FMultiGrid::solve (PArray<MultiFab>& phi,
     Real final_resnorm;
     m_mgt_solver->solve(phi_p, rhs_p, *m_bndry, rel_tol, abs_tol, 
 			always_use_bnorm, final_resnorm, need_grad_phi);
+
+    m_mgt_solver->park();
+
     return final_resnorm;
 }
 
@@ -234,29 +249,46 @@ void
 FMultiGrid::get_fluxes (PArray<MultiFab>& grad_phi, int ilev)
 {
     BL_ASSERT(ilev < m_nlevels);
+    BL_ASSERT(m_mgt_solver != 0);
+
+    m_mgt_solver->unpark();
 
     const Real* dx = m_geom[ilev].CellSize();
     m_mgt_solver->get_fluxes(ilev, grad_phi, dx);
+
+    m_mgt_solver->park();
 }
 
 void
 FMultiGrid::get_fluxes (Array<PArray<MultiFab> >& grad_phi)
 {
+    BL_ASSERT(m_mgt_solver != 0);
+
+    m_mgt_solver->unpark();
+
     for (int ilev = 0; ilev < m_nlevels; ++ilev) 
     {	
 	const Real* dx = m_geom[ilev].CellSize();
 	m_mgt_solver->get_fluxes(ilev, grad_phi[ilev], dx);
     }
+
+    m_mgt_solver->park();
 }
 
 void
 FMultiGrid::get_fluxes (PArray<PArray<MultiFab> >& grad_phi)
 {
+    BL_ASSERT(m_mgt_solver != 0);
+
+    m_mgt_solver->unpark();
+
     for (int ilev = 0; ilev < m_nlevels; ++ilev) 
     {
 	const Real* dx = m_geom[ilev].CellSize();
 	m_mgt_solver->get_fluxes(ilev, grad_phi[ilev], dx);
     }
+
+    m_mgt_solver->park();
 }
 
 void 
@@ -279,9 +311,8 @@ FMultiGrid::compute_residual (PArray<MultiFab> & phi,
 			      PArray<MultiFab> & res)
 {
     BL_ASSERT(  m_bc.initilized || m_bndry != 0);
-    BL_ASSERT(!(m_bc.initilized && m_bndry != 0));
+    BL_ASSERT(!(m_bc.initilized && m_bndry != 0 && !RAII_bndry.defined(0)));
     BL_ASSERT(m_coeff.eq_type != invalid_eq);
-    BL_ASSERT(m_mgt_solver == 0);
 
     MultiFab* phi_p[m_nlevels];
     MultiFab* rhs_p[m_nlevels];
@@ -296,6 +327,8 @@ FMultiGrid::compute_residual (PArray<MultiFab> & phi,
     init_mgt_solver(phi);
 
     m_mgt_solver->compute_residual(phi_p, rhs_p, res_p, *m_bndry);
+
+    m_mgt_solver->park();
 }
 
 void 
@@ -314,10 +347,9 @@ FMultiGrid::applyop (PArray<MultiFab> & phi,
 		     PArray<MultiFab> & res)
 {
     BL_ASSERT(  m_bc.initilized || m_bndry != 0);
-    BL_ASSERT(!(m_bc.initilized && m_bndry != 0));
+    BL_ASSERT(!(m_bc.initilized && m_bndry != 0 && !RAII_bndry.defined(0)));
     BL_ASSERT(m_coeff.eq_type != invalid_eq);
-    BL_ASSERT(m_mgt_solver == 0);
-    BL_ASSERT(m_bndry == 0);
+    BL_ASSERT(m_bc.initilized);
 
     MultiFab* phi_p[m_nlevels];
     MultiFab* res_p[m_nlevels];
@@ -330,6 +362,8 @@ FMultiGrid::applyop (PArray<MultiFab> & phi,
     init_mgt_solver(phi);
 
     m_mgt_solver->applyop(phi_p, res_p, *m_bndry);
+
+    m_mgt_solver->park();
 }
 
 void
@@ -482,10 +516,11 @@ FMultiGrid::ABecCoeff::set_coeffs (MGT_Solver & mgt_solver, FMultiGrid& fmg)
 void
 FMultiGrid::init_mgt_solver (PArray<MultiFab>& phi)
 {
+    BL_PROFILE("FMultiGrid::init_mgt_solver()");
+
     BL_ASSERT(  m_bc.initilized || m_bndry != 0);
-    BL_ASSERT(!(m_bc.initilized && m_bndry != 0));
+    BL_ASSERT(!(m_bc.initilized && m_bndry != 0 && !RAII_bndry.defined(0)));
     BL_ASSERT(m_coeff.eq_type != invalid_eq);
-    BL_ASSERT(m_mgt_solver == 0);
 
     int ncomp = phi[0].nComp();
 
@@ -524,6 +559,38 @@ FMultiGrid::init_mgt_solver (PArray<MultiFab>& phi)
         }
     }
 
+    //
+    // Reuse the solver from the last call if the grids and boundary
+    // conditions are the same, and only recompute the stencils if the
+    // coefficients have been changed since.
+    //
+    if (m_mgt_solver != 0)
+    {
+	if (ba == m_ba && dmap == m_dmap && ncomp == m_ncomp && mg_bc == m_mg_bc)
+	{
+	    m_mgt_solver->unpark();
+
+	    if (RAII_bndry.defined(0)) {
+		m_bc.set_bndry_values(*m_bndry, m_crse_ratio);
+	    }
+
+	    if (m_solver_coeff_version != m_coeff_version) {
+		m_coeff.set_coeffs(*m_mgt_solver, *this);
+		m_solver_coeff_version = m_coeff_version;
+	    }
+
+	    return;
+	}
+
+	RAII_mgt_solver.clear();
+	m_mgt_solver = 0;
+
+	if (RAII_bndry.defined(0)) {
+	    RAII_bndry.clear();
+	    m_bndry = 0;
+	}
+    }
+
     RAII_mgt_solver.resize(1, PArrayManage);
     RAII_mgt_solver.set(0, new MGT_Solver (m_geom, mg_bc.dataPtr() , ba, dmap, nodal,
 					   m_stencil, nodal, nc, ncomp, m_verbose));
@@ -540,4 +607,10 @@ FMultiGrid::init_mgt_solver (PArray<MultiFab>& phi)
     }
 
     m_coeff.set_coeffs(*m_mgt_solver, *this);
+
+    m_ba    = ba;
+    m_dmap  = dmap;
+    m_ncomp = ncomp;
+    m_mg_bc = mg_bc;
+    m_solver_coeff_version = m_coeff_version;
 }
@@ -159,7 +159,8 @@ MGT_Solver::MGT_Solver(const std::vector<Geometry>& geom,
     m_nlevel(grids.size()),
     m_grids(grids),
     m_nodal(nodal),
-    have_rhcc(_have_rhcc)
+    have_rhcc(_have_rhcc),
+    m_park_id(-1)
 {
     BL_ASSERT(geom.size()==m_nlevel);
     BL_ASSERT(dmap.size()==m_nlevel);
@@ -176,6 +177,8 @@ MGT_Solver::Build(const std::vector<Geometry>& geom,
                   int ncomp)
     
 {
+   BL_PROFILE("MGT_Solver::Build()");
+
    if (!initialized)
         initialize(m_nodal);
 
@@ -384,6 +387,8 @@ MGT_Solver::set_abeclap_coeffs (Real alpha,
 				const Array< Array<Real> >& xa,
 				const Array< Array<Real> >& xb)
 {
+    BL_PROFILE("MGT_Solver::set_abeclap_coeffs()");
+
     Array<Real> pxa(BL_SPACEDIM, 0.0);
     Array<Real> pxb(BL_SPACEDIM, 0.0);
 
@@ -428,6 +433,8 @@ MGT_Solver::set_abeclap_coeffs (const PArray<MultiFab>& aa,
 				const Array< Array<Real> >& xa,
 				const Array< Array<Real> >& xb)
 {
+    BL_PROFILE("MGT_Solver::set_abeclap_coeffs()");
+
     Array<Real> pxa(BL_SPACEDIM, 0.0);
     Array<Real> pxb(BL_SPACEDIM, 0.0);
 
@@ -469,6 +476,8 @@ MGT_Solver::set_abeclap_coeffs (Real alpha,
 				const Array< Array<Real> >& xa,
 				const Array< Array<Real> >& xb)
 {
+    BL_PROFILE("MGT_Solver::set_abeclap_coeffs()");
+
     Array<Real> pxa(BL_SPACEDIM, 0.0);
     Array<Real> pxb(BL_SPACEDIM, 0.0);
 
@@ -945,9 +954,27 @@ void MGT_Solver::fill_sync_resid(MultiFab* sync_resid, const MultiFab& msk,
   mgt_dealloc_nodal_sync();
 }
 
+void
+MGT_Solver::park ()
+{
+    BL_ASSERT(!m_nodal);
+    BL_ASSERT(m_park_id < 0);
+    mgt_park(&m_park_id);
+}
+
+void
+MGT_Solver::unpark ()
+{
+    BL_ASSERT(m_park_id >= 0);
+    mgt_unpark(&m_park_id);
+    m_park_id = -1;
+}
+
 MGT_Solver::~MGT_Solver()
 {
-  if (m_nodal) {
+  if (m_park_id >= 0) {
+    mgt_dealloc_parked(&m_park_id);
+  } else if (m_nodal) {
     if (have_rhcc) {
       mgt_dealloc_rhcc_nodal();      
     }
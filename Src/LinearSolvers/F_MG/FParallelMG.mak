@@ -38,6 +38,7 @@ f90EXE_sources += cc_stencil_fill.f90
 f90EXE_sources += cc_interface_stencil.f90
 f90EXE_sources += cc_mg_tower_smoother.f90
 f90EXE_sources += itsol.f90
+f90EXE_sources += bottom_direct.f90
 f90EXE_sources += mg.f90
 f90EXE_sources += mg_tower.f90
 f90EXE_sources += ml_cc.f90
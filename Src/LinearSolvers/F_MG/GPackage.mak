@@ -2,6 +2,7 @@ f90sources += stencil_types.f90
 f90sources += compute_defect.f90
 f90sources += coarsen_coeffs.f90
 f90sources += itsol.f90
+f90sources += bottom_direct.f90
 
 ifdef USE_MG_CPP
 f90sources += cc_mg_cpp.f90
@@ -0,0 +1,702 @@
+module bottom_direct_module
+
+  ! Direct bottom solver (bottom_solver = 5).
+  !
+  ! The bottom level operator is assembled by applying the stencil to sums of
+  ! unit vectors whose supports do not overlap, gathered onto the IO processor
+  ! and factored there as a banded LU (unknowns are numbered lexicographically
+  ! over the problem domain, so the band is about nx*ny wide in 3d).  The
+  ! factorization is kept in a small cache keyed on the bottom boxarray and on
+  ! the stencil and mask values, so it is reused across the solves made with
+  ! a tower as long as the coarsest level does not change; mg_tower_destroy
+  ! frees it.  Each bottom solve is then one residual, one gather, a
+  ! forward/back substitution on the IO processor and one broadcast.
+
+  use bl_constants_module
+  use bl_types
+  use bc_functions_module
+  use multifab_module
+  use stencil_defect_module, only : compute_defect, stencil_apply
+
+  implicit none
+
+  ! Largest banded factor (in reals) we are willing to build.  Bigger bottom
+  ! problems report failure and the caller falls back to an iterative solver.
+  integer, save :: bottom_direct_max_storage = 4194304
+
+  ! Stencil reach used to decide which unit vectors can be probed together.
+  integer, private, parameter :: probe_radius = 2
+  integer, private, parameter :: ncache = 4
+
+  type bottom_factor
+     logical :: built = .false.
+     logical :: usable = .false.
+     integer :: dim = 0
+     integer :: stencil_type = -1
+     logical :: nodal = .false.
+     logical :: singular = .false.
+     logical :: pmask(3) = .false.
+     integer :: plo(3) = 1, phi(3) = 1, period(3) = 1, ncolor(3) = 1
+     integer :: nunk = 0, kl = 0, ku = 0
+     type(boxarray) :: ba
+     integer   , pointer :: id(:,:,:) => Null()
+     integer   , pointer :: owner(:,:,:) => Null()
+     real(dp_t), pointer :: ss(:) => Null()
+     integer   , pointer :: mm(:) => Null()
+     real(dp_t), pointer :: band(:,:) => Null()
+  end type bottom_factor
+
+  type(bottom_factor), private, save, target :: factors(ncache)
+  integer, private, save :: next_slot = 1
+
+  private
+  public :: bottom_direct_solve, bottom_direct_clear, bottom_direct_max_storage
+
+contains
+
+  !
+  ! Solves ss * uu = rh on the bottom level.  stat is nonzero if the problem
+  ! is too large for (or cannot be factored by) the direct solver, in which
+  ! case uu is left untouched.
+  !
+  subroutine bottom_direct_solve(ss, uu, rh, mm, stencil_type, lcross, &
+                                 uniform_dh, singular, stat, verbose)
+
+    use bl_prof_module
+
+    type(multifab) , intent(in   ) :: ss
+    type(multifab) , intent(inout) :: uu
+    type(multifab) , intent(in   ) :: rh
+    type(imultifab), intent(in   ) :: mm
+    integer        , intent(in   ) :: stencil_type
+    logical        , intent(in   ) :: lcross, uniform_dh, singular
+    integer        , intent(  out) :: stat
+    integer        , intent(in   ), optional :: verbose
+
+    type(multifab)           :: rr
+    type(box)                :: bx
+    integer                  :: i, j, k, n, gi, lo(3), hi(3), c(3), lverbose
+    real(kind=dp_t), pointer :: rp(:,:,:,:), up(:,:,:,:)
+    real(kind=dp_t), allocatable :: b(:), x(:)
+    type(bottom_factor), pointer :: fac
+
+    type(bl_prof_timer), save :: bpt
+
+    call build(bpt, "bottom_direct_solve")
+
+    lverbose = 0; if ( present(verbose) ) lverbose = verbose
+
+    stat = 0
+
+    fac => get_factor(ss, mm, nghost(uu), stencil_type, lcross, uniform_dh, singular, lverbose)
+
+    if ( .not. fac%usable ) then
+       stat = 1
+       call destroy(bpt)
+       return
+    end if
+
+    call multifab_build(rr, get_layout(rh), 1, nghost(rh), nodal_flags(rh))
+    call compute_defect(ss, rr, rh, uu, mm, stencil_type, lcross, uniform_dh, bottom_solver=.true.)
+
+    allocate(b(fac%nunk), x(fac%nunk))
+    b = ZERO
+
+    do n = 1, nfabs(rr)
+       rp => dataptr(rr, n)
+       bx = get_ibox(rr, n)
+       gi = global_index(rr, n)
+       lo = 1; lo(1:fac%dim) = lwb(bx)
+       hi = 1; hi(1:fac%dim) = upb(bx)
+       do k = lo(3), hi(3)
+          do j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                c = canonical(fac, (/i,j,k/))
+                if ( fac%owner(c(1),c(2),c(3)) == gi .and. fac%id(c(1),c(2),c(3)) > 0 ) &
+                     b(fac%id(c(1),c(2),c(3))) = rp(i,j,k,1)
+             end do
+          end do
+       end do
+    end do
+
+    call multifab_destroy(rr)
+
+    call parallel_reduce(x, b, MPI_SUM, proc = parallel_IOProcessorNode())
+
+    if ( parallel_IOProcessor() ) then
+       if ( fac%singular ) x(fac%nunk) = ZERO
+       call band_lu_solve(fac%band, fac%kl, fac%ku, fac%nunk, x)
+    end if
+
+    call parallel_bcast(x)
+
+    do n = 1, nfabs(uu)
+       up => dataptr(uu, n)
+       bx = get_ibox(uu, n)
+       lo = 1; lo(1:fac%dim) = lwb(bx)
+       hi = 1; hi(1:fac%dim) = upb(bx)
+       do k = lo(3), hi(3)
+          do j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                c = canonical(fac, (/i,j,k/))
+                if ( fac%id(c(1),c(2),c(3)) > 0 ) &
+                     up(i,j,k,1) = up(i,j,k,1) + x(fac%id(c(1),c(2),c(3)))
+             end do
+          end do
+       end do
+    end do
+
+    deallocate(b, x)
+
+    call destroy(bpt)
+
+  end subroutine bottom_direct_solve
+
+  subroutine bottom_direct_clear()
+    integer :: i
+    do i = 1, ncache
+       call factor_destroy(factors(i))
+    end do
+    next_slot = 1
+  end subroutine bottom_direct_clear
+
+  !
+  ! Returns the cached factorization matching this bottom problem, building
+  ! it (in the least recently built slot) if there is none.
+  !
+  function get_factor(ss, mm, ng, stencil_type, lcross, uniform_dh, singular, verbose) result(fac)
+
+    type(bottom_factor), pointer :: fac
+    type(multifab) , intent(in) :: ss
+    type(imultifab), intent(in) :: mm
+    integer        , intent(in) :: ng, stencil_type, verbose
+    logical        , intent(in) :: lcross, uniform_dh, singular
+
+    integer :: i
+
+    do i = 1, ncache
+       if ( factor_matches(factors(i), ss, mm, stencil_type, singular) ) then
+          fac => factors(i)
+          return
+       end if
+    end do
+
+    fac => factors(next_slot)
+    next_slot = mod(next_slot, ncache) + 1
+
+    call factor_destroy(fac)
+    call factor_build(fac, ss, mm, ng, stencil_type, lcross, uniform_dh, singular, verbose)
+
+  end function get_factor
+
+  function factor_matches(fac, ss, mm, stencil_type, singular) result(r)
+
+    logical :: r
+    type(bottom_factor), intent(in) :: fac
+    type(multifab) , intent(in) :: ss
+    type(imultifab), intent(in) :: mm
+    integer        , intent(in) :: stencil_type
+    logical        , intent(in) :: singular
+
+    type(layout)             :: la
+    type(box)                :: pd
+    integer                  :: i, off, nsz, plo(3), phi(3)
+    logical                  :: lr
+    real(kind=dp_t), pointer :: sp(:,:,:,:)
+    integer        , pointer :: mp(:,:,:,:)
+
+    r = .false.
+
+    if ( .not. fac%built ) return
+
+    la = get_layout(ss)
+    pd = layout_get_pd(la)
+    plo = 1; plo(1:get_dim(ss)) = lwb(pd)
+    phi = 1; phi(1:get_dim(ss)) = upb(pd)
+
+    if ( fac%dim /= get_dim(ss) .or. fac%stencil_type /= stencil_type ) return
+    if ( (fac%nodal .neqv. nodal_q(mm)) .or. (fac%singular .neqv. singular) ) return
+    if ( any(fac%plo /= plo) .or. any(fac%period /= phi - plo + 1) ) return
+    if ( any(fac%pmask(1:fac%dim) .neqv. get_pmask(la)) ) return
+    if ( .not. boxarray_same_q(fac%ba, get_boxarray(la)) ) return
+    !
+    ! Same grids; now check that the stencil and masks we own are unchanged.
+    !
+    lr = .true.
+
+    nsz = 0
+    do i = 1, nfabs(ss)
+       nsz = nsz + size(dataptr(ss, i))
+    end do
+    if ( nsz /= size(fac%ss) ) lr = .false.
+
+    nsz = 0
+    do i = 1, nfabs(mm)
+       nsz = nsz + size(dataptr(mm, i))
+    end do
+    if ( nsz /= size(fac%mm) ) lr = .false.
+
+    if ( lr ) then
+       off = 0
+       do i = 1, nfabs(ss)
+          sp => dataptr(ss, i)
+          nsz = size(sp)
+          if ( any(reshape(sp, (/nsz/)) /= fac%ss(off+1:off+nsz)) ) then
+             lr = .false.
+             exit
+          end if
+          off = off + nsz
+       end do
+    end if
+
+    if ( lr ) then
+       off = 0
+       do i = 1, nfabs(mm)
+          mp => dataptr(mm, i)
+          nsz = size(mp)
+          if ( any(reshape(mp, (/nsz/)) /= fac%mm(off+1:off+nsz)) ) then
+             lr = .false.
+             exit
+          end if
+          off = off + nsz
+       end do
+    end if
+
+    call parallel_reduce(r, lr, MPI_LAND)
+
+  end function factor_matches
+
+  subroutine factor_build(fac, ss, mm, ng, stencil_type, lcross, uniform_dh, singular, verbose)
+
+    use bl_prof_module
+
+    type(bottom_factor), intent(inout) :: fac
+    type(multifab) , intent(in) :: ss
+    type(imultifab), intent(in) :: mm
+    integer        , intent(in) :: ng, stencil_type, verbose
+    logical        , intent(in) :: lcross, uniform_dh, singular
+
+    type(layout)                 :: la
+    type(boxarray)               :: ba
+    type(box)                    :: bx, pd
+    type(multifab)               :: vv, ww
+    integer                      :: i, j, k, n, m, gi, nsz, off, dm
+    integer                      :: lo(3), hi(3), c(3), q(3), col(3), ic, jc, kc
+    integer                      :: nent, maxent, kl, ku, nmax(2), nred(2)
+    integer                      :: nodal_dir(3)
+    logical                      :: ok
+    integer        , allocatable :: unk(:,:,:), unk_all(:,:,:)
+    integer        , allocatable :: erow(:), ecol(:)
+    real(kind=dp_t), allocatable :: eval(:), band(:,:)
+    real(kind=dp_t)              :: dummy(1)
+    real(kind=dp_t), pointer     :: sp(:,:,:,:), vp(:,:,:,:), wp(:,:,:,:)
+    integer        , pointer     :: mp(:,:,:,:)
+
+    type(bl_prof_timer), save :: bpt
+
+    call build(bpt, "bottom_direct_build")
+
+    dm = get_dim(ss)
+    la = get_layout(ss)
+    pd = layout_get_pd(la)
+    ba = get_boxarray(la)
+
+    fac%dim          = dm
+    fac%stencil_type = stencil_type
+    fac%nodal        = nodal_q(mm)
+    fac%singular     = singular
+    fac%pmask        = .false.
+    fac%pmask(1:dm)  = get_pmask(la)
+    fac%plo          = 1
+    fac%plo(1:dm)    = lwb(pd)
+    fac%phi          = 1
+    fac%phi(1:dm)    = upb(pd)
+    fac%period       = fac%phi - fac%plo + 1
+    !
+    ! Nodal problems have one more point than cells in each non-periodic
+    ! direction; periodic images are folded onto the low side.
+    !
+    nodal_dir = 0
+    if ( fac%nodal ) then
+       do i = 1, dm
+          if ( .not. fac%pmask(i) ) nodal_dir(i) = 1
+       end do
+    end if
+    fac%phi = fac%phi + nodal_dir
+    !
+    ! Points whose colors agree are more than 2*probe_radius apart, so their
+    ! columns can be probed with a single stencil application.  In periodic
+    ! directions the number of colors must divide the period.
+    !
+    fac%ncolor = 1
+    do i = 1, dm
+       fac%ncolor(i) = 2*probe_radius+1
+       if ( fac%pmask(i) ) then
+          if ( fac%period(i) <= 2*probe_radius+1 ) then
+             fac%ncolor(i) = fac%period(i)
+          else
+             do while ( mod(fac%period(i), fac%ncolor(i)) /= 0 )
+                fac%ncolor(i) = fac%ncolor(i) + 1
+             end do
+          end if
+       end if
+    end do
+
+    call copy(fac%ba, ba)
+
+    allocate(fac%id   (fac%plo(1):fac%phi(1),fac%plo(2):fac%phi(2),fac%plo(3):fac%phi(3)))
+    allocate(fac%owner(fac%plo(1):fac%phi(1),fac%plo(2):fac%phi(2),fac%plo(3):fac%phi(3)))
+    allocate(unk      (fac%plo(1):fac%phi(1),fac%plo(2):fac%phi(2),fac%plo(3):fac%phi(3)))
+    allocate(unk_all  (fac%plo(1):fac%phi(1),fac%plo(2):fac%phi(2),fac%plo(3):fac%phi(3)))
+    !
+    ! The lowest numbered box holding a point owns its row.
+    !
+    fac%owner = 0
+    do n = nboxes(ba), 1, -1
+       bx = box_nodalize(get_box(ba, n), nodal_flags(mm))
+       lo = 1; lo(1:dm) = lwb(bx)
+       hi = 1; hi(1:dm) = upb(bx)
+       do k = lo(3), hi(3)
+          do j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                c = canonical(fac, (/i,j,k/))
+                fac%owner(c(1),c(2),c(3)) = n
+             end do
+          end do
+       end do
+    end do
+    !
+    ! Every owned point is an unknown except nodal Dirichlet points.
+    !
+    unk = 0
+    do n = 1, nfabs(mm)
+       mp => dataptr(mm, n)
+       bx = get_ibox(mm, n)
+       gi = global_index(mm, n)
+       lo = 1; lo(1:dm) = lwb(bx)
+       hi = 1; hi(1:dm) = upb(bx)
+       do k = lo(3), hi(3)
+          do j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                c = canonical(fac, (/i,j,k/))
+                if ( fac%owner(c(1),c(2),c(3)) /= gi ) cycle
+                if ( fac%nodal ) then
+                   if ( bc_dirichlet(mp(i,j,k,1),1,0) ) cycle
+                end if
+                unk(c(1),c(2),c(3)) = 1
+             end do
+          end do
+       end do
+    end do
+
+    call reduce_ints(unk_all, unk, size(unk))
+
+    fac%nunk = 0
+    do k = fac%plo(3), fac%phi(3)
+       do j = fac%plo(2), fac%phi(2)
+          do i = fac%plo(1), fac%phi(1)
+             if ( unk_all(i,j,k) > 0 ) then
+                fac%nunk = fac%nunk + 1
+                fac%id(i,j,k) = fac%nunk
+             else
+                fac%id(i,j,k) = 0
+             end if
+          end do
+       end do
+    end do
+
+    deallocate(unk, unk_all)
+    !
+    ! Keep our part of the operator to recognize it next time.
+    !
+    nsz = 0
+    do n = 1, nfabs(ss)
+       nsz = nsz + size(dataptr(ss, n))
+    end do
+    allocate(fac%ss(nsz))
+    off = 0
+    do n = 1, nfabs(ss)
+       sp => dataptr(ss, n)
+       fac%ss(off+1:off+size(sp)) = reshape(sp, (/size(sp)/))
+       off = off + size(sp)
+    end do
+
+    nsz = 0
+    do n = 1, nfabs(mm)
+       nsz = nsz + size(dataptr(mm, n))
+    end do
+    allocate(fac%mm(nsz))
+    off = 0
+    do n = 1, nfabs(mm)
+       mp => dataptr(mm, n)
+       fac%mm(off+1:off+size(mp)) = reshape(mp, (/size(mp)/))
+       off = off + size(mp)
+    end do
+
+    fac%built = .true.
+    !
+    ! Probe the operator one color at a time, collecting the entries of the
+    ! rows we own.
+    !
+    maxent = 0
+    do n = 1, nfabs(mm)
+       maxent = maxent + int(volume(get_ibox(mm, n)))
+    end do
+    maxent = maxent * (2*probe_radius+1)**dm
+    allocate(erow(maxent), ecol(maxent), eval(maxent))
+    nent = 0
+
+    call multifab_build(vv, la, 1, ng, nodal_flags(mm))
+    call multifab_build(ww, la, 1, 0, nodal_flags(mm))
+
+    do kc = 0, fac%ncolor(3)-1
+    do jc = 0, fac%ncolor(2)-1
+    do ic = 0, fac%ncolor(1)-1
+
+       col = (/ic,jc,kc/)
+
+       call setval(vv, ZERO, all=.true.)
+
+       do n = 1, nfabs(vv)
+          vp => dataptr(vv, n)
+          bx = get_ibox(vv, n)
+          lo = 1; lo(1:dm) = lwb(bx)
+          hi = 1; hi(1:dm) = upb(bx)
+          do k = lo(3), hi(3)
+             do j = lo(2), hi(2)
+                do i = lo(1), hi(1)
+                   c = canonical(fac, (/i,j,k/))
+                   if ( fac%id(c(1),c(2),c(3)) == 0 ) cycle
+                   if ( all(mod(c - fac%plo, fac%ncolor) == col) ) vp(i,j,k,1) = ONE
+                end do
+             end do
+          end do
+       end do
+
+       call stencil_apply(ss, ww, vv, mm, stencil_type, lcross, uniform_dh, bottom_solver=.true.)
+
+       do n = 1, nfabs(ww)
+          wp => dataptr(ww, n)
+          bx = get_ibox(ww, n)
+          gi = global_index(ww, n)
+          lo = 1; lo(1:dm) = lwb(bx)
+          hi = 1; hi(1:dm) = upb(bx)
+          do k = lo(3), hi(3)
+             do j = lo(2), hi(2)
+                do i = lo(1), hi(1)
+                   if ( wp(i,j,k,1) == ZERO ) cycle
+                   c = canonical(fac, (/i,j,k/))
+                   if ( fac%owner(c(1),c(2),c(3)) /= gi .or. fac%id(c(1),c(2),c(3)) == 0 ) cycle
+                   if ( .not. probed_point(fac, c, col, q) ) cycle
+                   if ( fac%id(q(1),q(2),q(3)) == 0 ) cycle
+                   nent = nent + 1
+                   erow(nent) = fac%id(c(1),c(2),c(3))
+                   ecol(nent) = fac%id(q(1),q(2),q(3))
+                   eval(nent) = wp(i,j,k,1)
+                end do
+             end do
+          end do
+       end do
+
+    end do
+    end do
+    end do
+
+    call multifab_destroy(vv)
+    call multifab_destroy(ww)
+
+    kl = 0
+    ku = 0
+    do m = 1, nent
+       kl = max(kl, erow(m) - ecol(m))
+       ku = max(ku, ecol(m) - erow(m))
+    end do
+    nmax = (/kl, ku/)
+    call parallel_reduce(nred, nmax, MPI_MAX)
+    fac%kl = nred(1)
+    fac%ku = nred(2)
+
+    if ( real(fac%nunk,dp_t)*(fac%kl+fac%ku+1) > bottom_direct_max_storage ) then
+       if ( parallel_IOProcessor() .and. verbose > 0 ) then
+          print *,'F90mg: bottom problem too large for bottom_solver = 5: ', &
+               fac%nunk, ' unknowns, band ', fac%kl, fac%ku
+       end if
+       deallocate(erow, ecol, eval)
+       call destroy(bpt)
+       return
+    end if
+    !
+    ! Each row lives on exactly one processor so summing assembles the matrix.
+    !
+    allocate(band(-fac%kl:fac%ku, fac%nunk))
+    band = ZERO
+    do m = 1, nent
+       band(ecol(m)-erow(m), erow(m)) = eval(m)
+    end do
+    deallocate(erow, ecol, eval)
+
+    if ( parallel_IOProcessor() ) then
+       allocate(fac%band(-fac%kl:fac%ku, fac%nunk))
+       call reduce_band(fac%band, size(band), band, size(band))
+    else
+       call reduce_band(dummy, 1, band, size(band))
+    end if
+
+    deallocate(band)
+
+    ok = .true.
+    if ( parallel_IOProcessor() ) then
+       if ( fac%singular ) then
+          !
+          ! The null space is the constants: pin the last unknown.
+          !
+          fac%band(:,fac%nunk) = ZERO
+          fac%band(0,fac%nunk) = ONE
+       end if
+       call band_lu_factor(fac%band, fac%kl, fac%ku, fac%nunk, ok)
+    end if
+
+    call parallel_bcast(ok)
+
+    fac%usable = ok
+
+    if ( parallel_IOProcessor() ) then
+       if ( .not. ok ) then
+          deallocate(fac%band)
+          if ( verbose > 0 ) &
+             print *,'F90mg: zero pivot in bottom_solver = 5 factorization'
+       else if ( verbose > 1 ) then
+          print *,'F90mg: bottom_solver = 5 factored ', fac%nunk, &
+               ' unknowns, band ', fac%kl, fac%ku
+       end if
+    end if
+
+    call destroy(bpt)
+
+  end subroutine factor_build
+
+  subroutine factor_destroy(fac)
+    type(bottom_factor), intent(inout) :: fac
+    if ( .not. fac%built ) return
+    call destroy(fac%ba)
+    if ( associated(fac%id)    ) deallocate(fac%id)
+    if ( associated(fac%owner) ) deallocate(fac%owner)
+    if ( associated(fac%ss)    ) deallocate(fac%ss)
+    if ( associated(fac%mm)    ) deallocate(fac%mm)
+    if ( associated(fac%band)  ) deallocate(fac%band)
+    fac%built  = .false.
+    fac%usable = .false.
+    fac%nunk   = 0
+  end subroutine factor_destroy
+
+  !
+  ! Maps a point onto the index space of the unknowns, folding periodic images.
+  !
+  pure function canonical(fac, p) result(c)
+    integer :: c(3)
+    type(bottom_factor), intent(in) :: fac
+    integer, intent(in) :: p(3)
+    integer :: d
+    c = p
+    do d = 1, fac%dim
+       if ( fac%pmask(d) ) c(d) = fac%plo(d) + modulo(p(d) - fac%plo(d), fac%period(d))
+    end do
+  end function canonical
+
+  !
+  ! Finds the point of color col within probe_radius of c, if there is one.
+  !
+  function probed_point(fac, c, col, q) result(r)
+    logical :: r
+    type(bottom_factor), intent(in) :: fac
+    integer, intent(in) :: c(3), col(3)
+    integer, intent(out) :: q(3)
+    integer :: d, o, p(3)
+    p = c
+    r = .false.
+    do d = 1, 3
+       if ( d > fac%dim ) cycle
+       do o = -probe_radius, probe_radius
+          p(d) = c(d) + o
+          if ( fac%pmask(d) ) then
+             p(d) = fac%plo(d) + modulo(p(d) - fac%plo(d), fac%period(d))
+          else if ( p(d) < fac%plo(d) .or. p(d) > fac%phi(d) ) then
+             cycle
+          end if
+          if ( mod(p(d) - fac%plo(d), fac%ncolor(d)) == col(d) ) exit
+       end do
+       if ( o > probe_radius ) return
+    end do
+    q = p
+    r = .true.
+  end function probed_point
+
+  !
+  ! Sums the banded matrix onto the IO processor; r is only referenced there.
+  !
+  subroutine reduce_band(r, nr, a, n)
+    integer, intent(in) :: nr, n
+    real(kind=dp_t), intent(inout) :: r(nr)
+    real(kind=dp_t), intent(in) :: a(n)
+    call parallel_reduce(r, a, MPI_SUM, proc = parallel_IOProcessorNode())
+  end subroutine reduce_band
+
+  subroutine reduce_ints(r, a, n)
+    integer, intent(in) :: n
+    integer, intent(inout) :: r(n)
+    integer, intent(in) :: a(n)
+    call parallel_reduce(r, a, MPI_MAX)
+  end subroutine reduce_ints
+
+  !
+  ! In place LU factorization without pivoting of a matrix stored by rows,
+  ! a(j-i,i) = A(i,j).  The bottom operators are definite (or pinned), so no
+  ! pivoting is needed and the factors stay inside the band.
+  !
+  subroutine band_lu_factor(a, kl, ku, n, ok)
+    integer, intent(in) :: kl, ku, n
+    real(kind=dp_t), intent(inout) :: a(-kl:ku,n)
+    logical, intent(out) :: ok
+    integer :: i, j, k
+    real(kind=dp_t) :: piv, l
+    ok = .true.
+    do k = 1, n
+       piv = a(0,k)
+       if ( piv == ZERO ) then
+          ok = .false.
+          return
+       end if
+       !$OMP PARALLEL DO PRIVATE(i,j,l) IF(kl*ku > 4096)
+       do i = k+1, min(n,k+kl)
+          l = a(k-i,i)
+          if ( l /= ZERO ) then
+             l = l / piv
+             a(k-i,i) = l
+             do j = k+1, min(n,k+ku)
+                a(j-i,i) = a(j-i,i) - l*a(j-k,k)
+             end do
+          end if
+       end do
+       !$OMP END PARALLEL DO
+    end do
+  end subroutine band_lu_factor
+
+  subroutine band_lu_solve(a, kl, ku, n, x)
+    integer, intent(in) :: kl, ku, n
+    real(kind=dp_t), intent(in) :: a(-kl:ku,n)
+    real(kind=dp_t), intent(inout) :: x(n)
+    integer :: i, j
+    do i = 2, n
+       do j = max(1,i-kl), i-1
+          x(i) = x(i) - a(j-i,i)*x(j)
+       end do
+    end do
+    do i = n, 1, -1
+       do j = i+1, min(n,i+ku)
+          x(i) = x(i) - a(j-i,i)*x(j)
+       end do
+       x(i) = x(i) / a(0,i)
+    end do
+  end subroutine band_lu_solve
+
+end module bottom_direct_module
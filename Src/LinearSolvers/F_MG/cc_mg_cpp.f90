@@ -44,6 +44,9 @@ module cpp_mg_module
 
   type(mg_server), save   :: mgts
 
+  ! Solvers moved aside by mgt_park so that others can use mgts.
+  type(mg_server), allocatable, save :: mgts_parked(:)
+
 contains
   
   subroutine mgt_verify(str)
@@ -1123,6 +1126,83 @@ subroutine mgt_dealloc()
 
 end subroutine mgt_dealloc
 
+! ****************************************************************************
+! mgt_park moves the current solver aside, leaving mgts free for another one,
+! and returns its slot; mgt_unpark makes it the current solver again.  This
+! lets a solver keep its hierarchy and stencils between solves while other
+! solvers come and go.
+! ****************************************************************************
+
+subroutine mgt_park(id)
+  use cpp_mg_module
+  implicit none
+  integer, intent(out) :: id
+  type(mg_server) :: null_server
+  type(mg_server), allocatable :: tmp(:)
+  integer :: i, n
+
+  call mgt_verify("MGT_PARK")
+  if ( .not. mgts%final ) then
+     call bl_error("MGT_PARK: MGT not finalized")
+  end if
+
+  n = 0
+  if ( allocated(mgts_parked) ) n = size(mgts_parked)
+
+  id = 0
+  do i = 1, n
+     if ( mgts_parked(i)%dim == 0 ) then
+        id = i
+        exit
+     end if
+  end do
+
+  if ( id == 0 ) then
+     allocate(tmp(n+4))
+     if ( n > 0 ) tmp(1:n) = mgts_parked
+     call move_alloc(tmp, mgts_parked)
+     id = n+1
+  end if
+
+  mgts_parked(id) = mgts
+  mgts = null_server
+
+  id = id - 1
+
+end subroutine mgt_park
+
+subroutine mgt_unpark(id)
+  use cpp_mg_module
+  implicit none
+  integer, intent(in) :: id
+  type(mg_server) :: null_server
+
+  if ( mgts%dim /= 0 ) then
+     call bl_error("MGT_UNPARK: another MGT solver is in use")
+  end if
+  if ( mgts_parked(id+1)%dim == 0 ) then
+     call bl_error("MGT_UNPARK: nothing parked in slot ", id)
+  end if
+
+  mgts = mgts_parked(id+1)
+  mgts_parked(id+1) = null_server
+
+end subroutine mgt_unpark
+
+subroutine mgt_dealloc_parked(id)
+  use cpp_mg_module
+  implicit none
+  integer, intent(in) :: id
+  type(mg_server) :: current, null_server
+
+  current = mgts
+  mgts = mgts_parked(id+1)
+  call mgt_dealloc()
+  mgts_parked(id+1) = null_server
+  mgts = current
+
+end subroutine mgt_dealloc_parked
+
 subroutine mgt_solve(tol,abs_tol,needgradphi,final_resnorm,status,always_use_bnorm)
   use cpp_mg_module
   use ml_cc_module
@@ -12,7 +12,7 @@ module cc_stencil_apply_module
   private
   
   public  :: ml_fill_all_fluxes, &
-       stencil_apply_1d, stencil_apply_2d, stencil_apply_3d, &
+       stencil_apply_1d, stencil_apply_2d, stencil_apply_3d, stencil_apply_tile_3d, &
        stencil_flux_1d, stencil_flux_2d, stencil_flux_3d, &
        stencil_fine_flux_1d, stencil_fine_flux_2d, stencil_fine_flux_3d, &
        stencil_apply_ibc_2d, stencil_apply_ibc_3d
@@ -595,6 +595,179 @@ contains
 
   end subroutine stencil_apply_3d
 
+  !
+  ! stencil_apply_3d on the tile tlo:thi of the box starting at lo, for use
+  ! inside an OpenMP region over the tiles of an mfiter.  The i loops run
+  ! over the whole tile so that they vectorize.
+  !
+  subroutine stencil_apply_tile_3d(ss, dd, ng_d, uu, ng_u, mm, lo, tlo, thi, skwd)
+
+    integer           , intent(in ) :: ng_d,ng_u,lo(:),tlo(:),thi(:)
+    real (kind = dp_t), intent(in ) :: ss(0:,lo(1):,lo(2):,lo(3):)
+    real (kind = dp_t), intent(inout) :: dd(lo(1)-ng_d:,lo(2)-ng_d:,lo(3)-ng_d:)
+    real (kind = dp_t), intent(in ) :: uu(lo(1)-ng_u:,lo(2)-ng_u:,lo(3)-ng_u:)
+    integer           , intent(in ) :: mm(lo(1):,lo(2):,lo(3):)
+    logical           , intent(in ), optional :: skwd
+
+    integer            :: i,j,k,hi(3)
+    integer, parameter :: XBC = 7, YBC = 8, ZBC = 9
+    logical            :: lskwd
+
+    lskwd = .true.; if ( present(skwd) ) lskwd = skwd
+
+    hi = ubound(mm)
+
+    if ( size(ss,dim=1) .eq. 13 ) then
+       !
+       ! This is the Minion 4th order cross stencil.
+       ! 
+       do k = tlo(3),thi(3)
+          do j = tlo(2),thi(2)
+             do i = tlo(1),thi(1)
+                dd(i,j,k) = ss(0,i,j,k) * uu(i,j,k) &
+                     + ss( 1,i,j,k) * uu(i-2,j,k) + ss( 2,i,j,k) * uu(i-1,j,k) &
+                     + ss( 3,i,j,k) * uu(i+1,j,k) + ss( 4,i,j,k) * uu(i+2,j,k) &
+                     + ss( 5,i,j,k) * uu(i,j-2,k) + ss( 6,i,j,k) * uu(i,j-1,k) &
+                     + ss( 7,i,j,k) * uu(i,j+1,k) + ss( 8,i,j,k) * uu(i,j+2,k) &
+                     + ss( 9,i,j,k) * uu(i,j,k-2) + ss(10,i,j,k) * uu(i,j,k-1) &
+                     + ss(11,i,j,k) * uu(i,j,k+1) + ss(12,i,j,k) * uu(i,j,k+2)
+             end do
+          end do
+       end do
+
+    else if ( size(ss,dim=1) .eq. 61 ) then
+       !
+       ! This is the 4th order cross stencil for variable coefficients.
+       !
+       do k = tlo(3),thi(3)
+          do j = tlo(2),thi(2)
+             do i = tlo(1),thi(1)
+                dd(i,j,k) = &
+                       ss( 0,i,j,k) * uu(i  ,j  ,k  ) &
+                       ! Contributions from k-2
+                     + ss( 1,i,j,k) * uu(i  ,j-2,k-2) + ss( 2,i,j,k) * uu(i  ,j-1,k-2) &
+                     + ss( 3,i,j,k) * uu(i-2,j  ,k-2) + ss( 4,i,j,k) * uu(i-1,j  ,k-2) &
+                     + ss( 5,i,j,k) * uu(i  ,j  ,k-2) + ss( 6,i,j,k) * uu(i+1,j  ,k-2) &
+                     + ss( 7,i,j,k) * uu(i+2,j  ,k-2) + ss( 8,i,j,k) * uu(i  ,j+1,k-2) &
+                     + ss( 9,i,j,k) * uu(i  ,j+2,k-2)                                  &
+                       ! Contributions from k-1
+                     + ss(10,i,j,k) * uu(i  ,j-2,k-1) + ss(11,i,j,k) * uu(i  ,j-1,k-1) &
+                     + ss(12,i,j,k) * uu(i-2,j  ,k-1) + ss(13,i,j,k) * uu(i-1,j  ,k-1) &
+                     + ss(14,i,j,k) * uu(i  ,j  ,k-1) + ss(15,i,j,k) * uu(i+1,j  ,k-1) &
+                     + ss(16,i,j,k) * uu(i+2,j  ,k-1) + ss(17,i,j,k) * uu(i  ,j+1,k-1) &
+                     + ss(18,i,j,k) * uu(i  ,j+2,k-1)                                  &
+                       ! Contributions from j-2,k
+                     + ss(19,i,j,k) * uu(i-2,j-2,k  ) + ss(20,i,j,k) * uu(i-1,j-2,k  ) &
+                     + ss(21,i,j,k) * uu(i  ,j-2,k  ) + ss(22,i,j,k) * uu(i+1,j-2,k  ) &
+                     + ss(23,i,j,k) * uu(i+2,j-2,k  )                                  &
+                       ! Contributions from j-1,k
+                     + ss(24,i,j,k) * uu(i-2,j-1,k  ) + ss(25,i,j,k) * uu(i-1,j-1,k  ) &
+                     + ss(26,i,j,k) * uu(i  ,j-1,k  ) + ss(27,i,j,k) * uu(i+1,j-1,k  ) &
+                     + ss(28,i,j,k) * uu(i+2,j-1,k  )                                  &
+                       ! Contributions from j  ,k
+                     + ss(29,i,j,k) * uu(i-2,j  ,k  ) + ss(30,i,j,k) * uu(i-1,j  ,k  ) &
+                                                      + ss(31,i,j,k) * uu(i+1,j  ,k  ) &
+                     + ss(32,i,j,k) * uu(i+2,j  ,k  )                                  &
+                       ! Contributions from j+1,k
+                     + ss(33,i,j,k) * uu(i-2,j+1,k  ) + ss(34,i,j,k) * uu(i-1,j+1,k  ) &
+                     + ss(35,i,j,k) * uu(i  ,j+1,k  ) + ss(36,i,j,k) * uu(i+1,j+1,k  ) &
+                     + ss(37,i,j,k) * uu(i+2,j+1,k  )                                  &
+                       ! Contributions from j+2,k
+                     + ss(38,i,j,k) * uu(i-2,j+2,k  ) + ss(39,i,j,k) * uu(i-1,j+2,k  ) &
+                     + ss(40,i,j,k) * uu(i  ,j+2,k  ) + ss(41,i,j,k) * uu(i+1,j+2,k  ) &
+                     + ss(42,i,j,k) * uu(i+2,j+2,k  )                                  &
+                       ! Contributions from k+1
+                     + ss(43,i,j,k) * uu(i  ,j-2,k+1) + ss(44,i,j,k) * uu(i  ,j-1,k+1) &
+                     + ss(45,i,j,k) * uu(i-2,j  ,k+1) + ss(46,i,j,k) * uu(i-1,j  ,k+1) &
+                     + ss(47,i,j,k) * uu(i  ,j  ,k+1) + ss(48,i,j,k) * uu(i+1,j  ,k+1) &
+                     + ss(49,i,j,k) * uu(i+2,j  ,k+1) + ss(50,i,j,k) * uu(i  ,j+1,k+1) &
+                     + ss(51,i,j,k) * uu(i  ,j+2,k+1)                                  &
+                       ! Contributions from k+2
+                     + ss(52,i,j,k) * uu(i  ,j-2,k+2) + ss(53,i,j,k) * uu(i  ,j-1,k+2) &
+                     + ss(54,i,j,k) * uu(i-2,j  ,k+2) + ss(55,i,j,k) * uu(i-1,j  ,k+2) &
+                     + ss(56,i,j,k) * uu(i  ,j  ,k+2) + ss(57,i,j,k) * uu(i+1,j  ,k+2) &
+                     + ss(58,i,j,k) * uu(i+2,j  ,k+2) + ss(59,i,j,k) * uu(i  ,j+1,k+2) &
+                     + ss(60,i,j,k) * uu(i  ,j+2,k+2)
+             end do
+          end do
+       end do
+
+    else
+       !
+       ! This is the 2nd order cross stencil.
+       !
+       do k = tlo(3),thi(3)
+          do j = tlo(2),thi(2)
+             do i = tlo(1),thi(1)
+                dd(i,j,k) = &
+                     ss(0,i,j,k)*uu(i,j,k)       + &
+                     ss(1,i,j,k)*uu(i+1,j  ,k  ) + &
+                     ss(2,i,j,k)*uu(i-1,j  ,k  ) + &
+                     ss(3,i,j,k)*uu(i  ,j+1,k  ) + &
+                     ss(4,i,j,k)*uu(i  ,j-1,k  ) + &
+                     ss(5,i,j,k)*uu(i  ,j  ,k+1) + &
+                     ss(6,i,j,k)*uu(i  ,j  ,k-1)
+             end do
+          end do
+       end do
+
+    end if
+
+    if ( lskwd ) then
+       !
+       ! Corrections for skewed stencils on the faces of the box
+       !
+       if (hi(1) > lo(1)) then
+          do k = tlo(3), thi(3)
+             do j = tlo(2), thi(2)
+                i = lo(1)
+                if (tlo(1) == lo(1) .and. bc_skewed(mm(i,j,k),1,+1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(XBC,i,j,k)*uu(i+2,j,k)
+                end if
+
+                i = hi(1)
+                if (thi(1) == hi(1) .and. bc_skewed(mm(i,j,k),1,-1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(XBC,i,j,k)*uu(i-2,j,k)
+                end if
+             end do
+          end do
+       end if
+
+       if (hi(2) > lo(2)) then
+          do k = tlo(3), thi(3)
+             do i = tlo(1), thi(1)
+                j = lo(2)
+                if (tlo(2) == lo(2) .and. bc_skewed(mm(i,j,k),2,+1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(YBC,i,j,k)*uu(i,j+2,k)
+                end if
+
+                j = hi(2)
+                if (thi(2) == hi(2) .and. bc_skewed(mm(i,j,k),2,-1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(YBC,i,j,k)*uu(i,j-2,k)
+                end if
+             end do
+          end do
+       end if
+
+       if (hi(3) > lo(3)) then
+          do j = tlo(2), thi(2)
+             do i = tlo(1), thi(1)
+                k = lo(3)
+                if (tlo(3) == lo(3) .and. bc_skewed(mm(i,j,k),3,+1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(ZBC,i,j,k)*uu(i,j,k+2)
+                end if
+
+                k = hi(3)
+                if (thi(3) == hi(3) .and. bc_skewed(mm(i,j,k),3,-1)) then
+                   dd(i,j,k) = dd(i,j,k) + ss(ZBC,i,j,k)*uu(i,j,k-2)
+                end if
+             end do
+          end do
+       end if
+    end if
+
+  end subroutine stencil_apply_tile_3d
+
   subroutine stencil_apply_ibc_3d(ss, dd, ng_d, uu, ng_u, lo, hi)
 
     integer           , intent(in ) :: ng_d,ng_u, lo(:), hi(:)
@@ -46,8 +46,8 @@ contains
 
     use bl_prof_module
 
-    use cc_stencil_apply_module, only : stencil_apply_1d, stencil_apply_2d, stencil_apply_3d, &
-         stencil_apply_ibc_2d, stencil_apply_ibc_3d
+    use cc_stencil_apply_module, only : stencil_apply_1d, stencil_apply_2d, &
+         stencil_apply_tile_3d, stencil_apply_ibc_2d, stencil_apply_ibc_3d
     use nodal_stencil_apply_module, only: stencil_apply_1d_nodal, &
                                           stencil_apply_2d_nodal, &
                                           stencil_apply_3d_nodal
@@ -64,7 +64,10 @@ contains
     real(kind=dp_t), pointer :: rp(:,:,:,:), up(:,:,:,:), ap(:,:,:,:)
     integer        , pointer :: mp(:,:,:,:)
     integer                  :: i, n, lo(get_dim(rr)), hi(get_dim(rr)), dm
+    integer                  :: tlo(get_dim(rr)), thi(get_dim(rr))
     logical                  :: nodal_flag, luniform_dh, lbottom_solver, ldiagonalize, lfilled
+    type(mfiter)             :: mfi
+    type(box)                :: tilebox
 
     type(bl_prof_timer), save :: bpt
 
@@ -86,6 +89,34 @@ contains
     dm         = get_dim(rr)
     nodal_flag = nodal_q(uu)
 
+    if (dm == 3 .and. .not. nodal_flag) then
+       !
+       ! Cell-centered 3d stencils are applied tile by tile; the ibc
+       ! stencils are done below.
+       !
+       !$omp parallel private(mfi,i,n,tilebox,tlo,thi,lo,rp,up,ap,mp) if(.not.lbottom_solver)
+       call mfiter_build(mfi, rr, tiling=.true.)
+       do while(next_tile(mfi,i))
+          if (is_ibc_stencil(aa,i)) cycle
+
+          tilebox = get_tilebox(mfi)
+          tlo = lwb(tilebox)
+          thi = upb(tilebox)
+
+          rp => dataptr(rr, i)
+          up => dataptr(uu, i)
+          ap => dataptr(aa, i)
+          mp => dataptr(mm, i)
+          lo = lwb(get_box(uu,i))
+
+          do n = 1, ncomp(rr)
+             call stencil_apply_tile_3d(ap(:,:,:,:), rp(:,:,:,n), nghost(rr), up(:,:,:,n), nghost(uu),  &
+                  mp(:,:,:,1), lo, tlo, thi)
+          end do
+       end do
+       !$omp end parallel
+    end if
+
     do i = 1, nfabs(rr)
        rp => dataptr(rr, i)
        up => dataptr(uu, i)
@@ -126,8 +157,7 @@ contains
                 end if
              case (3)
                 if ( .not. nodal_flag) then
-                   call stencil_apply_3d(ap(:,:,:,:), rp(:,:,:,n), nghost(rr), up(:,:,:,n), nghost(uu),  &
-                        mp(:,:,:,1), bottom_solver=lbottom_solver)
+                   ! done above
                 else
                    call stencil_apply_3d_nodal(ap(1,:,:,:), rp(:,:,:,n), up(:,:,:,n),  &
                         mp(:,:,:,1), nghost(uu), nghost(rr), stencil_type, luniform_dh, lbottom_solver, ldiagonalize)
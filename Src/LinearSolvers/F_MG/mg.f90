@@ -459,11 +459,12 @@ contains
     end if
     !
     ! We do this *after* the test on bottom_solver == 4 in case we redefine bottom_solver
-    !    to be 1 or 2 in that test.
+    !    to be 1 or 2 in that test.  bottom_solver == 5 may fall back to BiCGStab.
     !
     if ( nodal_flag .and. (mgt%bottom_solver == 1 .or. &
                            mgt%bottom_solver == 2 .or. &
-                           mgt%bottom_solver == 3) ) then
+                           mgt%bottom_solver == 3 .or. &
+                           mgt%bottom_solver == 5) ) then
        call build_nodal_dot_mask(mgt%nodal_mask,mgt%cc(1))
     end if
 
@@ -544,6 +545,8 @@ contains
 
   recursive subroutine mg_tower_destroy(mgt,destroy_la)
 
+    use bottom_direct_module, only: bottom_direct_clear
+
     type(mg_tower), intent(inout) :: mgt
     logical, intent(in), optional :: destroy_la
 
@@ -591,6 +594,9 @@ contains
        deallocate(mgt%bottom_mgt)
     end if
 
+    ! The factorization lives on the IO processor and can be large.
+    if ( mgt%bottom_solver == 5 ) call bottom_direct_clear()
+
   end subroutine mg_tower_destroy
 
   function max_mg_levels(ba, nodal_flag, min_size) result(r)
@@ -774,6 +780,7 @@ contains
 
     use bl_prof_module
     use itsol_module, only: itsol_bicgstab_solve, itsol_cabicgstab_solve, itsol_cg_solve
+    use bottom_direct_module, only: bottom_direct_solve
 
     type( mg_tower), intent(inout) :: mgt
     type( multifab), intent(inout) :: uu
@@ -784,7 +791,7 @@ contains
     real(dp_t), intent(in), optional :: eps_in
 
     integer             :: i,stat,communicator,tag
-    logical             :: singular_test,do_diag
+    logical             :: singular_test,do_diag,lsingular
     real(dp_t)          :: nrm, eps
 
     type(bl_prof_timer), save :: bpt
@@ -885,6 +892,43 @@ contains
        do i = 1, mgt%nub
           call mg_tower_smoother(i, mgt, lev, ss, uu, rh, mm)
        end do
+    case (5)
+       !
+       ! Cached direct solve; too large a bottom problem falls back to BiCGStab.
+       !
+       if ( nodal_q(rh) ) then
+          lsingular = mgt%bottom_singular
+       else
+          lsingular = singular_test
+       end if
+       call bottom_direct_solve(ss, uu, rh, mm, mgt%stencil_type, mgt%lcross, &
+                                mgt%uniform_dh, lsingular, stat, mgt%verbose)
+       if ( stat /= 0 ) then
+          stat = 0
+          if ( nodal_q(rh) ) then
+             call itsol_bicgstab_solve(ss, uu, rh, mm, &
+                                       eps, mgt%bottom_max_iter, &
+                                       mgt%cg_verbose, &
+                                       mgt%stencil_type, mgt%lcross, &
+                                       stat = stat, &
+                                       singular_in = lsingular, &
+                                       uniform_dh = mgt%uniform_dh,&
+                                       nodal_mask = mgt%nodal_mask, &
+                                       comm_in = communicator)
+          else
+             call itsol_bicgstab_solve(ss, uu, rh, mm, &
+                                       eps, mgt%bottom_max_iter, &
+                                       mgt%cg_verbose,  &
+                                       mgt%stencil_type, mgt%lcross, &
+                                       stat = stat, &
+                                       singular_in = lsingular, &
+                                       uniform_dh = mgt%uniform_dh, &
+                                       comm_in = communicator)
+          end if
+       end if
+       do i = 1, mgt%nub
+          call mg_tower_smoother(i, mgt, lev, ss, uu, rh, mm)
+       end do
 
     case default
        call bl_error("MG_TOWER_BOTTOM_SOLVE: no such solver: ", mgt%bottom_solver)
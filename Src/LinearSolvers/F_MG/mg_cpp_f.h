@@ -23,6 +23,9 @@
 #define mgt_mc_finalize_stencil_lev  MGT_MC_FINALIZE_STENCIL_LEV
 #define mgt_finalize_nodal_stencil_lev  MGT_FINALIZE_NODAL_STENCIL_LEV
 #define mgt_dealloc               MGT_DEALLOC
+#define mgt_dealloc_parked        MGT_DEALLOC_PARKED
+#define mgt_park                  MGT_PARK
+#define mgt_unpark                MGT_UNPARK
 #define mgt_nodal_dealloc         MGT_NODAL_DEALLOC
 #define mgt_applyop               MGT_APPLYOP
 #define mgt_solve                 MGT_SOLVE
@@ -163,6 +166,9 @@
 #define mgt_mc_finalize_stencil_lev   mgt_mc_finalize_stencil_lev_
 #define mgt_finalize_nodal_stencil_lev  mgt_finalize_nodal_stencil_lev_
 #define mgt_dealloc               mgt_dealloc_
+#define mgt_dealloc_parked        mgt_dealloc_parked_
+#define mgt_park                  mgt_park_
+#define mgt_unpark                mgt_unpark_
 #define mgt_nodal_dealloc         mgt_nodal_dealloc_
 #define mgt_solve                 mgt_solve_
 #define mgt_applyop               mgt_applyop_
@@ -301,6 +307,9 @@
 #define mgt_mc_finalize_stencil_lev   mgt_mc_finalize_stencil_lev__
 #define mgt_finalize_nodal_stencil_lev  mgt_finalize_nodal_stencil_lev__
 #define mgt_dealloc               mgt_dealloc__
+#define mgt_dealloc_parked        mgt_dealloc_parked__
+#define mgt_park                  mgt_park__
+#define mgt_unpark                mgt_unpark__
 #define mgt_nodal_dealloc         mgt_nodal_dealloc__
 #define mgt_solve                 mgt_solve__
 #define mgt_applyop               mgt_applyop__
@@ -800,6 +809,10 @@ extern "C"
 
   void mgt_dealloc();
 
+  void mgt_park(int* id);
+  void mgt_unpark(const int* id);
+  void mgt_dealloc_parked(const int* id);
+
   void mgt_nodal_dealloc();
   
   void mgt_solve(const Real& tol, const Real& abs_tol, const int* need_grad_phi, Real* final_resnorm,
@@ -93,7 +93,7 @@ module mg_tower_module
      logical, pointer :: skewed_not_set(:) => Null()
      integer, pointer :: domain_bc(:,:)    => Null()
 
-     ! Only relevant if bottom_solver == 1, 2 or 3 AND nodal
+     ! Only relevant if bottom_solver == 1, 2, 3 or 5 AND nodal
      type(multifab) :: nodal_mask
 
      integer ::    verbose = 0
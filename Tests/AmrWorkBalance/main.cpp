@@ -0,0 +1,173 @@
+//
+// Check of the subcycling weights in Amr::estimateBoxWork() and the
+// MultiLevelMapKnapSack loads they give.  See README.
+//
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include <BoxLib.H>
+#include <Amr.H>
+#include <LevelBld.H>
+#include <ParmParse.H>
+#include <ParallelDescriptor.H>
+#include <DistributionMapping.H>
+#include <PROB_AMR_F.H>
+
+namespace
+{
+    //
+    // No AmrLevel is ever built; estimateBoxWork() only needs the work
+    // model and n_cycle.
+    //
+    class NoLevelBld
+        :
+        public LevelBld
+    {
+    public:
+        virtual void variableSetUp () override {}
+        virtual void variableCleanUp () override {}
+        virtual AmrLevel* operator() () override { return 0; }
+        virtual AmrLevel* operator() (Amr&, int, const Geometry&, const BoxArray&, Real) override
+        {
+            return 0;
+        }
+    };
+
+    NoLevelBld no_level_bld;
+
+    class WorkAmr
+        :
+        public Amr
+    {
+    public:
+        //
+        // The same cost per cell on every level, and ncycle subcycles
+        // per level (none if ncycle is 1).
+        //
+        void setWorkModel (Real seconds_per_cell, int ncycle)
+        {
+            for (int lev = 0; lev < work_per_cell.size(); lev++)
+                work_per_cell[lev] = seconds_per_cell;
+
+            sub_cycle  = ncycle > 1;
+            n_cycle[0] = 1;
+            for (int lev = 1; lev < n_cycle.size(); lev++)
+                n_cycle[lev] = ncycle;
+        }
+    };
+}
+
+LevelBld*
+getLevelBld ()
+{
+    return &no_level_bld;
+}
+//
+// Amr calls the problem's FORT_PROBINIT; there is no problem to set up.
+//
+extern "C"
+void
+FORT_PROBINIT (const int*, const int*, const int*, const Real*, const Real*)
+{}
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc,argv);
+    {
+        WorkAmr amr;
+
+        const int  nlevs = amr.maxLevel() + 1;
+        const bool IOP   = ParallelDescriptor::IOProcessor();
+
+        if (nlevs < 2)
+            BoxLib::Abort("need amr.max_level >= 1");
+        //
+        // Level 0 covers the domain, every finer level the middle half of
+        // the one below.
+        //
+        Array<BoxArray> allBoxes(nlevs);
+
+        Box bx = amr.Geom(0).Domain();
+
+        for (int lev = 0; lev < nlevs; lev++)
+        {
+            if (lev > 0)
+            {
+                const IntVect len = bx.size();
+                bx.grow(-len/4);
+                bx.refine(amr.refRatio(lev-1));
+            }
+            allBoxes[lev] = BoxArray(bx);
+            allBoxes[lev].maxSize(amr.maxGridSize(lev));
+        }
+
+        const int cycles[3] = { 1, 2, amr.MaxRefRatio(0) };
+
+        for (int c = 0; c < 3; c++)
+        {
+            const int ncycle = cycles[c];
+
+            amr.setWorkModel(1.e-7, ncycle);
+
+            const Array<Array<long> > work = amr.estimateBoxWork(allBoxes);
+
+            if (work.size() != nlevs)
+                BoxLib::Abort("estimateBoxWork returned no work; run with amr.calibrate_work = 1");
+
+            long steps = 1, total = 0;
+
+            if (IOP)
+                std::cout << "\nn_cycle = " << ncycle << '\n';
+
+            for (int lev = 0; lev < nlevs; lev++)
+            {
+                if (lev > 0) steps *= ncycle;
+
+                long levwork = 0;
+
+                for (int i = 0; i < allBoxes[lev].size(); i++)
+                {
+                    if (work[lev][i] != steps*allBoxes[lev][i].numPts())
+                        BoxLib::Abort("box work is not n_cycle^level times its cells");
+
+                    levwork += work[lev][i];
+                }
+
+                total += levwork;
+
+                if (IOP)
+                    std::cout << "  level " << lev << ": " << std::setw(4) << allBoxes[lev].size()
+                              << " boxes, " << std::setw(10) << allBoxes[lev].numPts()
+                              << " cells, work " << std::setw(11) << levwork << '\n';
+            }
+
+            const Array<Array<int> > pmap =
+                DistributionMapping::MultiLevelMapKnapSack(amr.refRatio(), allBoxes,
+                                                           amr.maxGridSize(0), work);
+
+            const int nprocs = ParallelDescriptor::NProcs();
+
+            Array<long> load(nprocs, 0);
+
+            for (int lev = 0; lev < nlevs; lev++)
+                for (int i = 0; i < allBoxes[lev].size(); i++)
+                    load[pmap[lev][i]] += work[lev][i];
+
+            const long maxload = *std::max_element(load.begin(), load.end());
+
+            if (IOP)
+            {
+                std::cout << "  knapsack loads:";
+                for (int p = 0; p < nprocs; p++)
+                    std::cout << ' ' << load[p];
+                std::cout << "\n  efficiency " << Real(total)/(Real(nprocs)*maxload) << '\n';
+            }
+        }
+
+        if (IOP)
+            std::cout << "\nestimateBoxWork weights are correct" << std::endl;
+    }
+    BoxLib::Finalize();
+}
@@ -0,0 +1,75 @@
+//
+// Checks MultiFabReduction against the individual MultiFab dot products
+// and norms.
+//
+#include <iostream>
+#include <cmath>
+#include <BoxArray.H>
+#include <MultiFab.H>
+#include <ParallelDescriptor.H>
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc, argv);
+
+    Box bx(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(63,63,63)));
+    BoxArray ba(bx);
+    ba.maxSize(16);
+
+    MultiFab x(ba, 2, 1), y(ba, 2, 1);
+
+    for (MFIter mfi(x); mfi.isValid(); ++mfi)
+    {
+        FArrayBox& xfab = x[mfi];
+        FArrayBox& yfab = y[mfi];
+        const Box& gbx  = xfab.box();
+        for (IntVect iv = gbx.smallEnd(); iv <= gbx.bigEnd(); gbx.next(iv))
+        {
+            for (int n = 0; n < 2; n++)
+            {
+                xfab(iv,n) = std::sin(0.1*(iv[0]+1) + n) * (1 + iv[BL_SPACEDIM-1]);
+                yfab(iv,n) = std::cos(0.2*iv[0] - iv[1]) - 0.5*n;
+            }
+        }
+    }
+
+    MultiFabReduction red;
+    const int i_dot = red.addDot(x, 0, y, 0);
+    const int i_d2  = red.addDot(x, 0, y, 0, 2, 1);
+    const int i_n0  = red.addNorm0(x, 1);
+    const int i_n0g = red.addNorm0(y, 0, 2, 1);
+    const int i_n1  = red.addNorm1(y, 1);
+    const int i_n2  = red.addNorm2(x, 0, 2);
+    red.reduce();
+
+    const Real ref[] = {
+        MultiFab::Dot(x, 0, y, 0, 1, 0),
+        MultiFab::Dot(x, 0, y, 0, 2, 1),
+        x.norm0(1),
+        std::max(y.norm0(0,1), y.norm0(1,1)),
+        y.norm1(1),
+        std::sqrt(x.norm2(0)*x.norm2(0) + x.norm2(1)*x.norm2(1))
+    };
+    const int idx[] = { i_dot, i_d2, i_n0, i_n0g, i_n1, i_n2 };
+
+    bool ok = true;
+
+    for (int i = 0; i < 6; i++)
+    {
+        const Real err = std::abs(red[idx[i]] - ref[i]) / std::max(std::abs(ref[i]), Real(1));
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "item " << i << ": " << red[idx[i]] << " vs " << ref[i] << '\n';
+
+        if (err > 1.e-12) ok = false;
+    }
+
+    if (!ok)
+        BoxLib::Abort("MultiFabReduction differs from the individual reductions");
+
+    if (ParallelDescriptor::IOProcessor())
+        std::cout << "MultiFabReduction OK\n";
+
+    BoxLib::Finalize();
+}
@@ -0,0 +1,105 @@
+//
+// Checks MultiFabUpdate against the equivalent sequence of MultiFab
+// LinComb, Saxpy and AddProduct calls and the MultiFab norms.
+//
+#include <iostream>
+#include <cmath>
+#include <BoxArray.H>
+#include <MultiFab.H>
+#include <ParallelDescriptor.H>
+
+static
+void
+Fill (MultiFab& mf, Real shift)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        FArrayBox& fab = mf[mfi];
+        const Box& gbx = fab.box();
+        for (IntVect iv = gbx.smallEnd(); iv <= gbx.bigEnd(); gbx.next(iv))
+            for (int n = 0; n < mf.nComp(); n++)
+                fab(iv,n) = std::sin(0.1*(iv[0]+1) + n + shift) * (1 + iv[BL_SPACEDIM-1]);
+    }
+}
+
+static
+Real
+MaxDiff (const MultiFab& a, const MultiFab& b, int nghost)
+{
+    MultiFab d(a.boxArray(), a.nComp(), nghost);
+    MultiFab::Copy(d, a, 0, 0, a.nComp(), nghost);
+    MultiFab::Subtract(d, b, 0, 0, a.nComp(), nghost);
+    Real err = 0;
+    for (int n = 0; n < a.nComp(); n++)
+        err = std::max(err, d.norm0(n, nghost));
+    return err;
+}
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc, argv);
+
+    Box bx(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(63,63,63)));
+    BoxArray ba(bx);
+    ba.maxSize(16);
+
+    MultiFab u0(ba, 2, 1), u1(ba, 2, 1), r(ba, 2, 1), u(ba, 2, 1), v(ba, 2, 1);
+
+    Fill(u0, 0.0);
+    Fill(u1, 1.0);
+    Fill(r,  2.0);
+    Fill(u, -1.0);
+    Fill(v, -1.0);
+
+    const Real a = 0.75, b = 0.25, c = 0.1;
+
+    bool ok = true;
+    //
+    // An RK stage: u = a*u0 + b*u1 + c*r, with the ghost cells.
+    //
+    MultiFab::LinComb(u, a, u0, 0, b, u1, 0, 0, 2, 1);
+    MultiFab::Saxpy(u, c, r, 0, 0, 2, 1);
+
+    MultiFabUpdate(v, 0, 2, 1).add(a, u0, 0).add(b, u1, 0).add(c, r, 0).eval();
+
+    Real err = MaxDiff(u, v, 1);
+    if (ParallelDescriptor::IOProcessor())
+        std::cout << "RK stage: " << err << '\n';
+    if (err > 1.e-13) ok = false;
+    //
+    // In place: u = 2*u + u0*r, with its L2 norm.
+    //
+    u.mult(2.0, 0, 2);
+    MultiFab::AddProduct(u, u0, 0, r, 0, 0, 2, 0);
+
+    const Real nm = MultiFabUpdate(v, 0, 2).scale(2.0).addProduct(1.0, u0, 0, r, 0).evalNorm(2);
+
+    const Real ref = std::sqrt(u.norm2(0)*u.norm2(0) + u.norm2(1)*u.norm2(1));
+
+    err = std::max(MaxDiff(u, v, 0), std::abs(nm - ref) / ref);
+    if (ParallelDescriptor::IOProcessor())
+        std::cout << "in place with norm: " << err << '\n';
+    if (err > 1.e-13) ok = false;
+    //
+    // One component, max and L1 norms.
+    //
+    MultiFab::Copy(u, u1, 1, 0, 1, 0);
+    MultiFab::Saxpy(u, -1.0, r, 1, 0, 1, 0);
+
+    const Real n0 = MultiFabUpdate(v, 0).add(1.0, u1, 1).add(-1.0, r, 1).evalNorm(0);
+    const Real n1 = MultiFabUpdate(v, 0).add(1.0, u1, 1).add(-1.0, r, 1).evalNorm(1);
+
+    err = std::max(std::abs(n0 - u.norm0(0)) / u.norm0(0), std::abs(n1 - u.norm1(0)) / u.norm1(0));
+    if (ParallelDescriptor::IOProcessor())
+        std::cout << "norms: " << err << '\n';
+    if (err > 1.e-12) ok = false;
+
+    if (!ok)
+        BoxLib::Abort("MultiFabUpdate differs from the individual operations");
+
+    if (ParallelDescriptor::IOProcessor())
+        std::cout << "MultiFabUpdate OK\n";
+
+    BoxLib::Finalize();
+}
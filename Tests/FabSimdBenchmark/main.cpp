@@ -0,0 +1,437 @@
+//
+// Bandwidth of the BaseFab<Real> primitives with each FabSimd kernel set,
+// against the Fortran kernels and STREAM.  See README.
+//
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
+
+#include <BoxLib.H>
+#include <MultiFab.H>
+#include <ParmParse.H>
+#include <ParallelDescriptor.H>
+#include <FabSimd.H>
+#include <BaseFab_f.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    enum Op { Dot = 0, Norm0, Norm1, Min, Max, Copy, SetVal, Plus, Mult, Saxpy, Xpay, Pack, NOps };
+
+    const char* OpNames[NOps] = { "dot", "norm0", "norm1", "min", "max",
+                                  "copy", "setVal", "plus", "mult", "saxpy", "xpay", "pack" };
+    //
+    // Reals read plus written per cell.
+    //
+    const int OpReals[NOps] = { 2, 1, 1, 1, 1, 2, 1, 3, 3, 3, 3, 4 };
+    //
+    // The ops the Fortran kernels did; min and max were BaseFab templates.
+    //
+    const bool HasFort[NOps] = { true, true, true, false, false,
+                                 true, true, true, true, true, true, true };
+
+    void
+    Fill (MultiFab& mf, Real shift)
+    {
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = mf[mfi];
+            const Box& bx  = fab.box();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+                fab(iv) = 1 + 1.e-3*std::sin(0.01*(D_TERM(iv[0],+3*iv[1],+7*iv[2])) + shift);
+        }
+    }
+    //
+    // The box of a tile op is applied to: the tile, or if slab > 0 its
+    // low x face slab that wide, like the ghost cells FillBoundary fills.
+    //
+    Box
+    OpBox (const MFIter& mfi, int slab)
+    {
+        Box bx = mfi.tilebox();
+        if (slab > 0)
+            bx.setBig(0, bx.smallEnd(0)+slab-1);
+        return bx;
+    }
+    //
+    // The cells op is applied to, over all processors.
+    //
+    Real
+    OpCells (MultiFab& x, int slab)
+    {
+        Real n = 0;
+        for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+            n += OpBox(mfi,slab).d_numPts();
+        ParallelDescriptor::ReduceRealSum(n);
+        return n;
+    }
+    //
+    // Applies op to the tiles of x and y; returns the local reduction, if any.
+    // The threads' partial reductions are combined in no particular order, so
+    // use serial to get the same bits every time.
+    //
+    Real
+    Apply (int op, bool fortran, MultiFab& x, MultiFab& y, int slab, bool serial = false)
+    {
+        const Real a  = 1.e-3;
+        const int  nc = 1;
+
+        Real sm = 0, mx = -std::numeric_limits<Real>::max(), mn = std::numeric_limits<Real>::max();
+
+#ifdef _OPENMP
+#pragma omp parallel if (!serial)
+#endif
+        {
+            Real tsm = 0, tmx = mx, tmn = mn;
+
+            std::vector<Real> buf;
+
+            for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+            {
+                const Box  bx = OpBox(mfi,slab);
+                FArrayBox& xf = x[mfi];
+                FArrayBox& yf = y[mfi];
+
+                if (fortran)
+                {
+                    switch (op)
+                    {
+                    case Dot:
+                        tsm += fort_fab_dot(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                            BL_TO_FORTRAN_N_3D(xf,0),
+                                            BL_TO_FORTRAN_N_3D(yf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case Norm0:
+                    case Norm1:
+                    {
+                        const int p = (op == Norm0) ? 0 : 1;
+                        const Real nm = fort_fab_norm(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                                      BL_TO_FORTRAN_N_3D(xf,0), &nc, &p);
+                        if (p == 0) tmx = std::max(tmx, nm); else tsm += nm;
+                        break;
+                    }
+                    case Copy:
+                        fort_fab_copy(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                      BL_TO_FORTRAN_N_3D(yf,0),
+                                      BL_TO_FORTRAN_N_3D(xf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case SetVal:
+                        fort_fab_setval(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                        BL_TO_FORTRAN_N_3D(yf,0), &nc, &a);
+                        break;
+                    case Plus:
+                        fort_fab_plus(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                      BL_TO_FORTRAN_N_3D(yf,0),
+                                      BL_TO_FORTRAN_N_3D(xf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case Mult:
+                        fort_fab_mult(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                      BL_TO_FORTRAN_N_3D(yf,0),
+                                      BL_TO_FORTRAN_N_3D(xf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case Saxpy:
+                        fort_fab_saxpy(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                       BL_TO_FORTRAN_N_3D(yf,0), &a,
+                                       BL_TO_FORTRAN_N_3D(xf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case Xpay:
+                        fort_fab_xpay(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                      BL_TO_FORTRAN_N_3D(yf,0), &a,
+                                      BL_TO_FORTRAN_N_3D(xf,0), ARLIM_3D(bx.loVect()), &nc);
+                        break;
+                    case Pack:
+                        buf.resize(bx.numPts());
+                        fort_fab_copytomem(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                           &buf[0], BL_TO_FORTRAN_N_3D(xf,0), &nc);
+                        fort_fab_copyfrommem(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                             BL_TO_FORTRAN_N_3D(yf,0), &nc, &buf[0]);
+                        break;
+                    }
+                }
+                else
+                {
+                    switch (op)
+                    {
+                    case Dot:    tsm += xf.dot(bx,0,yf,bx,0,1);              break;
+                    case Norm0:  tmx  = std::max(tmx, xf.norm(bx,0,0,1));    break;
+                    case Norm1:  tsm += xf.norm(bx,1,0,1);                   break;
+                    case Min:    tmn  = std::min(tmn, xf.min(bx,0));         break;
+                    case Max:    tmx  = std::max(tmx, xf.max(bx,0));         break;
+                    case Copy:   yf.copy(xf,bx,0,bx,0,1);                    break;
+                    case SetVal: yf.setVal(a,bx,0,1);                        break;
+                    case Plus:   yf.plus(xf,bx,bx,0,0,1);                    break;
+                    case Mult:   yf.mult(xf,bx,bx,0,0,1);                    break;
+                    case Saxpy:  yf.saxpy(a,xf,bx,bx,0,0,1);                 break;
+                    case Xpay:   yf.xpay(a,xf,bx,bx,0,0,1);                  break;
+                    case Pack:
+                        buf.resize(bx.numPts());
+                        xf.copyToMem(bx,0,1,&buf[0]);
+                        yf.copyFromMem(bx,0,1,&buf[0]);
+                        break;
+                    }
+                }
+            }
+#ifdef _OPENMP
+#pragma omp critical(fsbench_reduce)
+#endif
+            {
+                sm += tsm;
+                mx  = std::max(mx, tmx);
+                mn  = std::min(mn, tmn);
+            }
+        }
+
+        switch (op)
+        {
+        case Norm0: case Max: return mx;
+        case Min:             return mn;
+        default:              return sm;
+        }
+    }
+    //
+    // Fastest of ntimes, in seconds.
+    //
+    Real
+    Time (int op, bool fortran, MultiFab& x, MultiFab& y, int slab, int ntimes)
+    {
+        Real best = std::numeric_limits<Real>::max();
+
+        for (int i = 0; i < ntimes; i++)
+        {
+            ParallelDescriptor::Barrier();
+            const Real strt = ParallelDescriptor::second();
+            Apply(op, fortran, x, y, slab);
+            Real t = ParallelDescriptor::second() - strt;
+            ParallelDescriptor::ReduceRealMax(t);
+            best = std::min(best, t);
+        }
+
+        return best;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc,argv);
+
+    ParmParse pp;
+
+    int n_cell = 256, max_grid_size = 64, ntimes = 10, slab = 2;
+    pp.query("n_cell", n_cell);
+    pp.query("max_grid_size", max_grid_size);
+    pp.query("ntimes", ntimes);
+    pp.query("slab", slab);
+
+    std::vector<std::string> isas;
+    if (pp.contains("isa"))
+        pp.queryarr("isa", isas);
+    else
+    {
+        isas.push_back("generic"); isas.push_back("avx2"); isas.push_back("avx512");
+    }
+
+    Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+
+    MultiFab x(ba,1,0), y(ba,1,0);
+
+    const Real ncells = domain.d_numPts();
+    const Real GB     = 1.e9;
+
+    const bool IOP = ParallelDescriptor::IOProcessor();
+
+    if (IOP)
+    {
+        std::cout << "n_cell = " << n_cell << ", max_grid_size = " << max_grid_size
+                  << ", ntimes = " << ntimes << ", slab = " << slab;
+#ifdef _OPENMP
+        std::cout << ", threads = " << omp_get_max_threads();
+#endif
+        std::cout << '\n';
+    }
+    //
+    // The kernel sets to run, and "fortran".
+    //
+    std::vector<std::string> cols;
+
+    for (int i = 0; i < isas.size(); i++)
+    {
+        FabSimd::ISA isa = (isas[i] == "avx512") ? FabSimd::AVX512 :
+                           (isas[i] == "avx2")   ? FabSimd::AVX2 : FabSimd::Generic;
+
+        if (FabSimd::Supported(isa))
+            cols.push_back(FabSimd::Name(isa));
+        else if (IOP)
+            std::cout << '\n' << isas[i] << " isn't supported, skipping";
+    }
+    cols.push_back("fortran");
+
+    //
+    // Whole tiles, then thin slabs, where the time per pencil dominates.
+    //
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int w = (pass == 0) ? 0 : slab;
+
+        if (pass == 1 && slab <= 0) break;
+
+        const Real cells = OpCells(x, w);
+
+        if (IOP)
+        {
+            if (w == 0)
+                std::cout << "\nGB/s\n";
+            else
+                std::cout << "\nGB/s on x face slabs " << w << " cells wide\n";
+            std::cout << std::setw(8) << "op";
+            for (int c = 0; c < cols.size(); c++)
+                std::cout << std::setw(10) << cols[c];
+            std::cout << '\n';
+        }
+
+        std::vector< std::vector<Real> > gbs(NOps, std::vector<Real>(cols.size(), 0));
+        std::vector< std::vector<Real> > red(NOps, std::vector<Real>(cols.size(), 0));
+
+        const FabSimd::ISA selected = FabSimd::Selected();
+
+        for (int c = 0; c < cols.size(); c++)
+        {
+            const bool fortran = (cols[c] == "fortran");
+
+            if (!fortran)
+            {
+                FabSimd::Select(cols[c] == "avx512" ? FabSimd::AVX512 :
+                                cols[c] == "avx2"   ? FabSimd::AVX2 : FabSimd::Generic);
+            }
+
+            Fill(x, 0.0);
+            Fill(y, 1.0);
+
+            for (int op = 0; op < NOps; op++)
+            {
+                if (fortran && !HasFort[op]) continue;
+
+                if (op <= Max)
+                    red[op][c] = Apply(op, fortran, x, y, w, true);
+
+                const Real t = Time(op, fortran, x, y, w, ntimes);
+
+                gbs[op][c] = OpReals[op]*sizeof(Real)*cells / t / GB;
+            }
+        }
+
+        FabSimd::Select(selected);
+
+        if (IOP)
+        {
+            for (int op = 0; op < NOps; op++)
+            {
+                std::cout << std::setw(8) << OpNames[op] << std::fixed << std::setprecision(2);
+                for (int c = 0; c < cols.size(); c++)
+                {
+                    if (cols[c] == "fortran" && !HasFort[op])
+                        std::cout << std::setw(10) << "-";
+                    else
+                        std::cout << std::setw(10) << gbs[op][c];
+                }
+                std::cout << '\n';
+            }
+        }
+        //
+        // Every kernel set must give the same reductions.
+        //
+        for (int op = Dot; op <= Max; op++)
+        {
+            for (int c = 1; c < cols.size(); c++)
+            {
+                if (cols[c] != "fortran" && red[op][c] != red[op][0])
+                {
+                    std::cout << OpNames[op] << ", slab " << w << ": " << cols[c] << " gives " << red[op][c]
+                              << ", " << cols[0] << " " << red[op][0] << '\n';
+                    BoxLib::Abort("FabSimd kernel sets differ");
+                }
+            }
+        }
+    }
+
+    //
+    // STREAM on plain arrays of the same size.
+    //
+    const long N = long(ncells);
+
+    Real* A = new Real[N];
+    Real* B = new Real[N];
+    Real* C = new Real[N];
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (long i = 0; i < N; i++)
+    {
+        A[i] = 1; B[i] = 2; C[i] = 0;
+    }
+
+    const char* StreamNames[4] = { "Copy", "Scale", "Add", "Triad" };
+    const int   StreamReals[4] = { 2, 2, 3, 3 };
+    const Real  s = 3;
+
+    if (IOP) std::cout << "\nSTREAM GB/s\n";
+
+    for (int k = 0; k < 4; k++)
+    {
+        Real best = std::numeric_limits<Real>::max();
+
+        for (int rep = 0; rep < ntimes; rep++)
+        {
+            const Real strt = ParallelDescriptor::second();
+
+            switch (k)
+            {
+            case 0:
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (long i = 0; i < N; i++) C[i] = A[i];
+                break;
+            case 1:
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (long i = 0; i < N; i++) B[i] = s*C[i];
+                break;
+            case 2:
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (long i = 0; i < N; i++) C[i] = A[i]+B[i];
+                break;
+            case 3:
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (long i = 0; i < N; i++) A[i] = B[i]+s*C[i];
+                break;
+            }
+
+            best = std::min(best, ParallelDescriptor::second() - strt);
+        }
+
+        if (IOP)
+            std::cout << std::setw(8) << StreamNames[k] << std::setw(10)
+                      << StreamReals[k]*sizeof(Real)*ncells / best / GB << '\n';
+    }
+
+    delete [] A;
+    delete [] B;
+    delete [] C;
+
+    BoxLib::Finalize();
+}
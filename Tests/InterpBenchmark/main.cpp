@@ -0,0 +1,279 @@
+//
+// Benchmark and check of the cell-centered linear conservative interpolation.
+// See README.
+//
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+#include <BoxLib.H>
+#include <FArrayBox.H>
+#include <Geometry.H>
+#include <ParmParse.H>
+#include <ParallelDescriptor.H>
+#include <Utility.H>
+#include <Interpolater.H>
+#include <INTERP_F.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    //
+    // The interpolation as it was done before FORT_LINCCINTERP2, with all
+    // the slope arrays allocated for every call and all components at once.
+    //
+    void
+    OldLinCC (const FArrayBox& crse, FArrayBox& fine, int ncomp,
+              const Box& fine_region, const IntVect& ratio,
+              const Geometry& crse_geom, const Geometry& fine_geom,
+              const Array<BCRec>& bcr, int lin_limit)
+    {
+        Box target_fine_region = fine_region & fine.box();
+        Box cslope_bx = BoxLib::coarsen(target_fine_region,ratio);
+        Box crse_bx   = BoxLib::grow(cslope_bx,1);
+        Box fine_version_of_cslope_bx = BoxLib::refine(cslope_bx,ratio);
+
+        Array<Real> fvc[BL_SPACEDIM];
+        Array<Real> cvc[BL_SPACEDIM];
+        for (int dir = 0; dir < BL_SPACEDIM; dir++)
+        {
+            fine_geom.GetEdgeVolCoord(fvc[dir],fine_version_of_cslope_bx,dir);
+            crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+        }
+
+        FArrayBox ucc_slopes(cslope_bx,ncomp*BL_SPACEDIM);
+        FArrayBox lcc_slopes(cslope_bx,ncomp*BL_SPACEDIM);
+        FArrayBox slope_factors(cslope_bx,BL_SPACEDIM);
+        FArrayBox cmax(cslope_bx,ncomp);
+        FArrayBox cmin(cslope_bx,ncomp);
+        FArrayBox alpha(cslope_bx,ncomp);
+
+        const int* flo    = fine.loVect();
+        const int* fhi    = fine.hiVect();
+        const int* clo    = crse.loVect();
+        const int* chi    = crse.hiVect();
+        const int* fblo   = target_fine_region.loVect();
+        const int* fbhi   = target_fine_region.hiVect();
+        const int* csbhi  = cslope_bx.hiVect();
+        const int* csblo  = cslope_bx.loVect();
+        const int* cvcblo = crse_bx.loVect();
+        const int* fvcblo = fine_version_of_cslope_bx.loVect();
+        int slope_flag    = 1;
+        int actual_comp   = 0;
+        int actual_state  = 0;
+
+        int cvcbhi[BL_SPACEDIM];
+        int fvcbhi[BL_SPACEDIM];
+        for (int dir = 0; dir < BL_SPACEDIM; dir++)
+        {
+            cvcbhi[dir] = cvcblo[dir] + cvc[dir].size() - 1;
+            fvcbhi[dir] = fvcblo[dir] + fvc[dir].size() - 1;
+        }
+
+        D_TERM(Real* voffx = new Real[fvc[0].size()];,
+               Real* voffy = new Real[fvc[1].size()];,
+               Real* voffz = new Real[fvc[2].size()];);
+
+        Array<int> bc(2*BL_SPACEDIM*ncomp);
+        for (int n = 0; n < ncomp; n++)
+            for (int m = 0; m < 2*BL_SPACEDIM; m++)
+                bc[2*BL_SPACEDIM*n + m] = bcr[n].vect()[m];
+
+        const int* ratioV = ratio.getVect();
+
+        FORT_LINCCINTERP (fine.dataPtr(),ARLIM(flo),ARLIM(fhi),
+                          fblo, fbhi,
+                          ARLIM(fvcblo), ARLIM(fvcbhi),
+                          crse.dataPtr(),ARLIM(clo),ARLIM(chi),
+                          ARLIM(cvcblo), ARLIM(cvcbhi),
+                          ucc_slopes.dataPtr(0), lcc_slopes.dataPtr(0), slope_factors.dataPtr(0),
+#if (BL_SPACEDIM>=2)
+                          ucc_slopes.dataPtr(ncomp), lcc_slopes.dataPtr(ncomp), slope_factors.dataPtr(1),
+#endif
+#if (BL_SPACEDIM==3)
+                          ucc_slopes.dataPtr(2*ncomp), lcc_slopes.dataPtr(2*ncomp), slope_factors.dataPtr(2),
+#endif
+                          ARLIM(csblo), ARLIM(csbhi),
+                          csblo, csbhi,
+                          &ncomp,D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
+                          bc.dataPtr(), &slope_flag, &lin_limit,
+                          D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
+                          D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
+                          D_DECL(voffx,voffy,voffz),
+                          alpha.dataPtr(),cmax.dataPtr(),cmin.dataPtr(),
+                          &actual_comp,&actual_state);
+
+        D_TERM(delete [] voffx;, delete [] voffy;, delete [] voffz;);
+    }
+    //
+    // Splits the fine region into refinements of coarse boxes tile cells wide.
+    //
+    std::vector<Box>
+    CrseAlignedTiles (const Box& fine_region, const IntVect& ratio, int tile)
+    {
+        std::vector<Box> cboxes(1, BoxLib::coarsen(fine_region,ratio));
+
+        for (int d = 0; d < BL_SPACEDIM; ++d)
+        {
+            std::vector<Box> pieces;
+            for (int i = 0; i < cboxes.size(); ++i)
+            {
+                Box cbx = cboxes[i];
+                while (cbx.length(d) >= 2*tile)
+                    pieces.push_back(cbx.chop(d, cbx.bigEnd(d)-tile+1));
+                pieces.push_back(cbx);
+            }
+            cboxes.swap(pieces);
+        }
+
+        std::vector<Box> tiles;
+        for (int i = 0; i < cboxes.size(); ++i)
+            tiles.push_back(BoxLib::refine(cboxes[i],ratio) & fine_region);
+        return tiles;
+    }
+
+    bool
+    Identical (const FArrayBox& a, const FArrayBox& b)
+    {
+        return std::memcmp(a.dataPtr(), b.dataPtr(), a.box().numPts()*a.nComp()*sizeof(Real)) == 0;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc,argv);
+
+    int n_cell = 64;
+    int ratio  = 2;
+    int ncomp  = 4;
+    int nreps  = 5;
+    int tile   = 4;
+
+    ParmParse pp;
+    pp.query("n_cell", n_cell);
+    pp.query("ratio",  ratio);
+    pp.query("ncomp",  ncomp);
+    pp.query("nreps",  nreps);
+    pp.query("tile",   tile);
+
+    BL_ASSERT(tile >= 2);
+    //
+    // The fine region covers the whole fine domain, so the coarse data
+    // extends one cell outside the coarse domain.  The low sides are
+    // EXT_DIR, which exercises the one-sided slopes.
+    //
+    const IntVect rr(D_DECL(ratio,ratio,ratio));
+    const Box fdomain(IntVect::TheZeroVector(), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+    const Box cdomain = BoxLib::coarsen(fdomain,rr);
+
+    RealBox rb(D_DECL(0.,0.,0.), D_DECL(1.,1.,1.));
+    Geometry cgeom(cdomain, &rb, 0);
+    Geometry fgeom(fdomain, &rb, 0);
+
+    Array<BCRec> bcs(ncomp);
+    for (int n = 0; n < ncomp; ++n)
+        for (int d = 0; d < BL_SPACEDIM; ++d)
+        {
+            bcs[n].setLo(d, EXT_DIR);
+            bcs[n].setHi(d, FOEXTRAP);
+        }
+
+    FArrayBox crse(BoxLib::grow(cdomain,1), ncomp);
+    BoxLib::InitRandom(451);
+    for (IntVect iv = crse.box().smallEnd(); iv <= crse.box().bigEnd(); crse.box().next(iv))
+        for (int n = 0; n < ncomp; ++n)
+            crse(iv,n) = std::sin(0.3*D_TERM(iv[0],+2*iv[1],+3*iv[2]) + n) + 0.1*BoxLib::Random();
+
+    const std::vector<Box> tiles = CrseAlignedTiles(fdomain, rr, tile);
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    std::cout << "InterpBenchmark: n_cell = " << n_cell << ", ratio = " << ratio
+              << ", ncomp = " << ncomp << ", " << tiles.size() << " tiles, "
+              << nthreads << " threads\n\n";
+
+    std::cout << std::setw(10) << "limiting"
+              << std::setw(14) << "old"
+              << std::setw(14) << "new"
+              << std::setw(14) << "new tiled"
+              << std::setw(12) << "identical"
+              << std::setw(14) << "tiled diff" << '\n';
+
+    std::cout << std::setprecision(4);
+
+    bool ok = true;
+
+    for (int lin_limit = 0; lin_limit <= 1; ++lin_limit)
+    {
+        CellConservativeLinear mapper(lin_limit == 1);
+
+        FArrayBox fine_old(fdomain, ncomp);
+        FArrayBox fine_new(fdomain, ncomp);
+        FArrayBox fine_tiled(fdomain, ncomp);
+
+        Real t_old = 1.e200, t_new = 1.e200, t_tiled = 1.e200;
+
+        for (int rep = 0; rep < nreps; ++rep)
+        {
+            Array<BCRec> bcr(ncomp);
+            BoxLib::setBC(fdomain,fdomain,0,0,ncomp,bcs,bcr);
+
+            fine_old.setVal(0);
+            Real t0 = ParallelDescriptor::second();
+            OldLinCC(crse, fine_old, ncomp, fdomain, rr, cgeom, fgeom, bcr, lin_limit);
+            t_old = std::min(t_old, ParallelDescriptor::second() - t0);
+
+            fine_new.setVal(0);
+            t0 = ParallelDescriptor::second();
+            mapper.interp(crse, 0, fine_new, 0, ncomp, fdomain, rr, cgeom, fgeom, bcr, 0, 0);
+            t_new = std::min(t_new, ParallelDescriptor::second() - t0);
+
+            fine_tiled.setVal(0);
+            t0 = ParallelDescriptor::second();
+            const int N = tiles.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int i = 0; i < N; ++i)
+            {
+                Array<BCRec> tbcr(ncomp);
+                BoxLib::setBC(tiles[i],fdomain,0,0,ncomp,bcs,tbcr);
+                mapper.interp(crse, 0, fine_tiled, 0, ncomp, tiles[i], rr, cgeom, fgeom, tbcr, 0, 0);
+            }
+            t_tiled = std::min(t_tiled, ParallelDescriptor::second() - t0);
+        }
+
+        //
+        // The tiles get their edge coordinates from GetEdgeVolCoord on
+        // smaller regions, which can change the last bit when dx is not a
+        // power of two.
+        //
+        const bool same = Identical(fine_old,fine_new);
+        fine_tiled.minus(fine_old);
+        const Real tiled_diff = fine_tiled.norm(0);
+        ok = ok && same && tiled_diff < 1.e-12;
+
+        std::cout << std::setw(10) << lin_limit
+                  << std::setw(14) << t_old
+                  << std::setw(14) << t_new
+                  << std::setw(14) << t_tiled
+                  << std::setw(12) << (same ? "yes" : "NO")
+                  << std::setw(14) << tiled_diff << '\n';
+    }
+
+    if (!ok)
+        BoxLib::Abort("InterpBenchmark: results differ from FORT_LINCCINTERP");
+
+    BoxLib::Finalize();
+
+    return 0;
+}
@@ -298,6 +298,8 @@ main (int argc, char* argv[])
 
   bool use_variable_coef=false; pp.query("use_variable_coef", use_variable_coef);
 
+  bool check_mixed_precision=false; pp.query("check_mixed_precision", check_mixed_precision);
+
   int res;
 
   if ( !ABec )
@@ -491,6 +493,39 @@ main (int argc, char* argv[])
 
 	      if (ParallelDescriptor::IOProcessor())
                   std::cout << "Run time = " << run_stop << std::endl;
+
+              if ( check_mixed_precision )
+              {
+                  //
+                  // Solve again with the corrections computed in single
+                  // precision; the final residual must match the double
+                  // precision solve.
+                  //
+                  MultiFab soln_sp(bs, Ncomp, Nghost, Fab_allocate); soln_sp.setVal(0.0);
+
+                  MultiGrid mg_sp(lp);
+                  mg_sp.setMixedPrecision(1);
+                  mg_sp.solve(soln_sp, rhs, tolerance, tolerance_abs);
+
+                  MultiFab resid(bs, Ncomp, 0, Fab_allocate);
+                  lp.residual(resid, rhs, soln, 0, LinOp::Inhomogeneous_BC);
+                  const Real res_dp = mfnorm_0_valid(resid);
+                  lp.residual(resid, rhs, soln_sp, 0, LinOp::Inhomogeneous_BC);
+                  const Real res_sp = mfnorm_0_valid(resid);
+
+                  MultiFab::Subtract(soln_sp, soln, 0, 0, Ncomp, 0);
+                  const Real dsoln = mfnorm_0_valid(soln_sp);
+
+                  if (ParallelDescriptor::IOProcessor())
+                  {
+                      std::cout << "Final residual: double = " << res_dp
+                                << ", mixed precision = " << res_sp << std::endl;
+                      std::cout << "Max solution difference = " << dsoln << std::endl;
+                  }
+
+                  if ( res_sp > 2*res_dp )
+                      BoxLib::Abort("mixed precision solve did not reach the double precision residual");
+              }
           }
 	  if ( cg )
           {
@@ -0,0 +1,321 @@
+// Solver benchmark.  With benchmark = 1 the problem of main.cpp is solved
+// for every combination of bench.n_cell, bench.max_grid_size and
+// bench.sigma (the contrast of beta), bench.nrepeat times with each of
+// the selected solvers, and a row per solve is appended to the CSV file
+// bench.outfile.  A row has the wall time of the solve, including the
+// operator and solver setup, and the time spent in each of the phases in
+// phase_table below.  A phase time is the sum of the exclusive BL_PROFILE
+// times of its functions, maxed over processes, so the phases are only
+// filled in if the code is built with TINY_PROFILE=TRUE or PROFILE=TRUE;
+// otherwise they are -1.  Since the times are exclusive, e.g. operator
+// applications in the bottom solver count as residual, not bottom.  The
+// V-cycles of F_MG are Fortran and only show up as a whole in fsolve.
+//
+// The numbers of MPI ranks and threads are swept by running the
+// executable several times with the same bench.outfile, see run_bench.sh.
+
+#include <fstream>
+#include <iomanip>
+
+#include <Utility.H>
+#include <ParallelDescriptor.H>
+#include <ParmParse.H>
+#include <PArray.H>
+#include <MultiFab.H>
+#include <Geometry.H>
+#include <LO_BCTYPES.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+void build_grids(std::vector<Geometry>& geom,
+		 std::vector<BoxArray>& grids,
+		 int n_cell, int max_grid_size);
+void setup_coef(PArray<MultiFab> &exac, PArray<MultiFab> &alph,
+		PArray<MultiFab> &beta, PArray<MultiFab> &rhs,
+		const std::vector<Geometry>& geom,
+		const std::vector<BoxArray>& grids,
+		Real a, Real b, Real sigma, Real w);
+void solve_with_Cpp(PArray<MultiFab>& soln, Real a, Real b,
+		    const PArray<MultiFab>& alph,
+		    const PArray<MultiFab>& beta,
+		    PArray<MultiFab>& rhs,
+		    const std::vector<Geometry>& geom,
+		    const std::vector<BoxArray>& grids,
+		    int ibnd);
+void solve_with_F90(PArray<MultiFab>& soln, Real a, Real b,
+		    const PArray<MultiFab>& alph,
+		    const PArray<MultiFab>& beta,
+		    PArray<MultiFab>& rhs,
+		    const std::vector<Geometry>& geom,
+		    const std::vector<BoxArray>& grids,
+		    int ibnd);
+#ifdef USEHYPRE
+void solve_with_hypre(PArray<MultiFab>& soln, Real a, Real b,
+		      const PArray<MultiFab>& alph,
+		      const PArray<MultiFab>& beta,
+		      PArray<MultiFab>& rhs,
+		      const std::vector<Geometry>& geom,
+		      const std::vector<BoxArray>& grids,
+		      int ibnd);
+#endif
+
+namespace
+{
+  //
+  // The phases and the BL_PROFILE names of their functions.  Building the
+  // FillBoundary and copy metadata is setup; it is cached afterwards.
+  //
+  const char* setup_names[] = {
+    "MultiGrid::prepareForLevel()", "LinOp::prepareForLevel()",
+    "LinOp::makeCoefficients()", "MultiGrid::buildAgglomeration()",
+    "ABecLaplacian::buildHaloCoefficients()",
+    "FabArrayBase::getFB()", "FabArrayBase::FB::FB()",
+    "FabArrayBase::getCPC()", "FabArrayBase::CPC::define()",
+    "MGT_Solver::Build()", "MGT_Solver::set_abeclap_coeffs()", 0 };
+
+  const char* smoothing_names[] = {
+    "MultiGrid::relax()", "ABecLaplacian::Fsmooth()",
+    "ABecLaplacian::Fsmooth_jacobi()", "ABecLaplacian::smoothDeepHalo()",
+    "Laplacian::Fsmooth()", "LinOp::applyBC()", "LinOp::applyPhysBC()", 0 };
+
+  const char* residual_names[] = {
+    "LinOp::residual()", "ABecLaplacian::Fapply()", "Laplacian::Fapply()",
+    "ABecLaplacian::norm()", 0 };
+
+  const char* restriction_names[] = {
+    "MultiGrid::average()", "MultiGrid::residualAverage()", 0 };
+
+  const char* interpolation_names[] = {
+    "MultiGrid::interpolate()", 0 };
+
+  const char* bottom_names[] = {
+    "MultiGrid::coarsestSmooth()", "MultiGrid::agglomeratedSmooth()",
+    "CGSolver::solve_cg()", "CGSolver::solve_bicgstab()",
+    "CGSolver::solve_cabicgstab()", "CGSolver::solve_pipecg()",
+    "CGSolver::solve_pipebicgstab()", "CGSolver::sxay()", "CGSolver::dotxy()",
+    "MultiFabReduction::computeLocal()", 0 };
+
+  const char* communication_names[] = {
+    "FabArray::FillBoundary()", "FabArray::EnforcePeriodicity",
+    "FabArray::copy()", "FabArrayCopyDescriptor::CollectData()",
+    "MultiFab::SumBoundary()", "MultiFabReduction::reduce()", "ReduceRealMax",
+    "ParallelDescriptor::util::DoAllReduceReal()",
+    "ParallelDescriptor::util::DoReduceReal()",
+    "ParallelDescriptor::util::DoIAllReduceReal()",
+    "ParallelDescriptor::Message::wait()", "ParallelDescriptor::Waitsome()",
+    "ParallelDescriptor::Barrier()", 0 };
+
+  const char* fsolve_names[] = {
+    "MGT_Solver::solve()", 0 };
+
+  struct Phase
+  {
+    const char*  name;
+    const char** timers;
+  };
+
+  const Phase phase_table[] = {
+    { "setup",         setup_names         },
+    { "smoothing",     smoothing_names     },
+    { "residual",      residual_names      },
+    { "restriction",   restriction_names   },
+    { "interpolation", interpolation_names },
+    { "bottom",        bottom_names        },
+    { "communication", communication_names },
+    { "fsolve",        fsolve_names        } };
+
+  const int NPhases = sizeof(phase_table) / sizeof(Phase);
+
+  bool have_profiler ()
+  {
+#if defined(BL_PROFILING) || defined(BL_TINY_PROFILING)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void get_phase_times (Array<Real>& t)
+  {
+    t.resize(NPhases);
+
+    for (int p = 0; p < NPhases; p++) {
+      t[p] = 0.0;
+      for (const char** nm = phase_table[p].timers; *nm != 0; ++nm) {
+	long ncalls;
+	Real dt;
+#ifdef BL_TINY_PROFILING
+	TinyProfiler::GetExclusiveTime(*nm, ncalls, dt);
+#else
+	BLProfiler::GetExclusiveTime(*nm, ncalls, dt);
+#endif
+	t[p] += dt;
+      }
+    }
+  }
+
+  void write_header (std::ostream& os)
+  {
+    os << "solver,dim,nprocs,nthreads,bc,n_cell,max_grid_size,ngrids,sigma,repeat,wall";
+    for (int p = 0; p < NPhases; p++) {
+      os << ',' << phase_table[p].name;
+    }
+    os << ",other\n";
+  }
+}
+
+void run_benchmark (int ibnd, bool do_cpp, bool do_f90, bool do_hypre)
+{
+  Real a, b, sigma, w;
+  int n_cell, max_grid_size;
+  {
+    ParmParse pp;
+    pp.get("a",  a);
+    pp.get("b",  b);
+    pp.get("sigma", sigma);
+    pp.get("w", w);
+    pp.get("n_cell",n_cell);
+    pp.get("max_grid_size",max_grid_size);
+  }
+
+  std::vector<int>  n_cells(1, n_cell);
+  std::vector<int>  max_grid_sizes(1, max_grid_size);
+  std::vector<Real> sigmas(1, sigma);
+  int nrepeat = 3;
+  std::string outfile = "bench.csv";
+  {
+    ParmParse pp("bench");
+    pp.queryarr("n_cell", n_cells);
+    pp.queryarr("max_grid_size", max_grid_sizes);
+    pp.queryarr("sigma", sigmas);
+    pp.query("nrepeat", nrepeat);
+    pp.query("outfile", outfile);
+  }
+
+  std::vector<std::string> solvers;
+  if (do_cpp)   solvers.push_back("BoxLib_C");
+  if (do_f90)   solvers.push_back("BoxLib_F");
+  if (do_hypre) solvers.push_back("Hypre");
+
+  const int nprocs = ParallelDescriptor::NProcs();
+#ifdef _OPENMP
+  const int nthreads = omp_get_max_threads();
+#else
+  const int nthreads = 1;
+#endif
+  const char* bc_name = (ibnd == 0) ? "Periodic" :
+                        (ibnd == LO_DIRICHLET) ? "Dirichlet" : "Neumann";
+
+  std::ofstream ofs;
+  if (ParallelDescriptor::IOProcessor()) {
+    bool new_file;
+    {
+      std::ifstream ifs(outfile.c_str());
+      new_file = !ifs.good() || ifs.peek() == std::ifstream::traits_type::eof();
+    }
+    ofs.open(outfile.c_str(), std::ios::out|std::ios::app);
+    if (!ofs.good()) {
+      BoxLib::FileOpenFailed(outfile);
+    }
+    if (new_file) {
+      write_header(ofs);
+    }
+    if (!have_profiler()) {
+      std::cout << "Built without a profiler: only wall times are reported in "
+		<< outfile << std::endl;
+    }
+  }
+
+  const int nlevel = 1;
+
+  for (int in = 0; in < n_cells.size(); in++) {
+    for (int ig = 0; ig < max_grid_sizes.size(); ig++) {
+
+      std::vector<Geometry> geom(nlevel);
+      std::vector<BoxArray> grids(nlevel);
+
+      build_grids(geom, grids, n_cells[in], max_grid_sizes[ig]);
+
+      for (int is = 0; is < sigmas.size(); is++) {
+
+	PArray<MultiFab> soln(nlevel, PArrayManage);
+	PArray<MultiFab> exac(nlevel, PArrayManage);
+	PArray<MultiFab> alph(nlevel, PArrayManage);
+	PArray<MultiFab> beta(nlevel, PArrayManage);
+	PArray<MultiFab> rhs(nlevel, PArrayManage);
+
+	soln.set(0, new MultiFab(grids[0], 1, 1));
+	exac.set(0, new MultiFab(grids[0], 1, 0));
+	alph.set(0, new MultiFab(grids[0], 1, 0));
+	beta.set(0, new MultiFab(grids[0], 1, 1)); // one ghost cell
+	rhs.set (0, new MultiFab(grids[0], 1, 0));
+
+	setup_coef(exac, alph, beta, rhs, geom, grids, a, b, sigmas[is], w);
+
+	for (int isol = 0; isol < solvers.size(); isol++) {
+	  for (int irep = 0; irep < nrepeat; irep++) {
+
+	    soln[0].setVal(0.0);
+
+	    Array<Real> t0, t1;
+	    get_phase_times(t0);
+
+	    ParallelDescriptor::Barrier();
+	    const Real strt = ParallelDescriptor::second();
+
+	    if (solvers[isol] == "BoxLib_C") {
+	      solve_with_Cpp(soln, a, b, alph, beta, rhs, geom, grids, ibnd);
+	    }
+	    else if (solvers[isol] == "BoxLib_F") {
+	      solve_with_F90(soln, a, b, alph, beta, rhs, geom, grids, ibnd);
+	    }
+#ifdef USEHYPRE
+	    else {
+	      solve_with_hypre(soln, a, b, alph, beta, rhs, geom, grids, ibnd);
+	    }
+#endif
+
+	    Real wall = ParallelDescriptor::second() - strt;
+
+	    get_phase_times(t1);
+
+	    Array<Real> times(NPhases+1);
+	    times[0] = wall;
+	    for (int p = 0; p < NPhases; p++) {
+	      times[p+1] = t1[p] - t0[p];
+	    }
+
+	    ParallelDescriptor::ReduceRealMax(times.dataPtr(), times.size(),
+					      ParallelDescriptor::IOProcessorNumber());
+
+	    if (ParallelDescriptor::IOProcessor()) {
+	      wall = times[0];
+	      Real other = wall;
+	      ofs << solvers[isol] << ',' << BL_SPACEDIM << ',' << nprocs << ',' << nthreads
+		  << ',' << bc_name << ',' << n_cells[in] << ',' << max_grid_sizes[ig]
+		  << ',' << grids[0].size() << ',' << sigmas[is] << ',' << irep
+		  << ',' << std::setprecision(6) << wall;
+	      for (int p = 0; p < NPhases; p++) {
+		if (have_profiler()) {
+		  ofs << ',' << times[p+1];
+		  other -= times[p+1];
+		} else {
+		  ofs << ",-1";
+		}
+	      }
+	      ofs << ',' << (have_profiler() ? std::max(other, Real(0.0)) : Real(-1.0)) << '\n';
+	      ofs.flush();
+
+	      std::cout << "BENCH " << solvers[isol] << " n_cell = " << n_cells[in]
+			<< " max_grid_size = " << max_grid_sizes[ig]
+			<< " sigma = " << sigmas[is] << " repeat " << irep
+			<< ": " << wall << " s" << std::endl;
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
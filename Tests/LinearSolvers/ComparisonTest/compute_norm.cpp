@@ -69,9 +69,8 @@ void compute_norm(const PArray<MultiFab>& soln, const PArray<MultiFab>& exac,
   if (ParallelDescriptor::IOProcessor()) {
     if (iCpp >= 0) {
       std::cout << "----------------------------------------" << std::endl;
-      std::cout << "BoxLib_C: not implemented yet. " << std::endl;
-      //      std::cout << "BoxLib_C: max-norm error = "<< maxnorm[iCpp] << std::endl;
-      //      std::cout << "BoxLib_C:   2-norm error = "<< twonorm[iCpp] << std::endl;
+      std::cout << "BoxLib_C: max-norm error = "<< maxnorm[iCpp] << std::endl;
+      std::cout << "BoxLib_C:   2-norm error = "<< twonorm[iCpp] << std::endl;
     }
     if (iF90 >= 0) {
       std::cout << "----------------------------------------" << std::endl;
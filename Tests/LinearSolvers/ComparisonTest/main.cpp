@@ -23,12 +23,20 @@ solver_t solver_type = All;
 bc_t     bc_type = Periodic;
 
 void build_grids(std::vector<Geometry>& geom, 
-		 std::vector<BoxArray>& grids);
+		 std::vector<BoxArray>& grids,
+		 int n_cell, int max_grid_size);
 void setup_coef(PArray<MultiFab> &exac, PArray<MultiFab> &alph, 
 		PArray<MultiFab> &beta, PArray<MultiFab> &rhs, 
 		const std::vector<Geometry>& geom, 
 		const std::vector<BoxArray>& grids,
 		Real a, Real b, Real sigma, Real w);
+void solve_with_Cpp(PArray<MultiFab>& soln, Real a, Real b, 
+		    const PArray<MultiFab>& alph, 
+		    const PArray<MultiFab>& beta, 
+		    PArray<MultiFab>& rhs, 
+		    const std::vector<Geometry>& geom, 
+		    const std::vector<BoxArray>& grids,
+		    int ibnd);
 void solve_with_F90(PArray<MultiFab>& soln, Real a, Real b, 
 		    const PArray<MultiFab>& alph, 
 		    const PArray<MultiFab>& beta, 
@@ -48,6 +56,7 @@ void solve_with_hypre(PArray<MultiFab>& soln, Real a, Real b,
 void compute_norm(const PArray<MultiFab>& soln, const PArray<MultiFab>& exac, 
 		  const std::vector<Geometry>& geom, const std::vector<BoxArray>& grids,
 		  int nsoln, int iCpp, int iF90, int iHyp);
+void run_benchmark(int ibnd, bool do_cpp, bool do_f90, bool do_hypre);
 
 int main(int argc, char* argv[])
 {
@@ -102,6 +111,21 @@ int main(int argc, char* argv[])
     }
   }
 
+  int benchmark = 0;
+  pp.query("benchmark", benchmark);
+  if (benchmark) {
+    bool do_hypre = false;
+#ifdef USEHYPRE
+    do_hypre = (solver_type == Hypre || solver_type == All);
+#endif
+    run_benchmark(static_cast<int>(bc_type), 
+		  solver_type == BoxLib_C || solver_type == All,
+		  solver_type == BoxLib_F || solver_type == All,
+		  do_hypre);
+    BoxLib::Finalize();
+    return 0;
+  }
+
   int max_level = 0;
   pp.query("max_level", max_level);
   int nlevel = max_level+1;
@@ -109,7 +133,15 @@ int main(int argc, char* argv[])
   std::vector<Geometry> geom(nlevel);
   std::vector<BoxArray> grids(nlevel);
 
-  build_grids(geom, grids);
+  {
+    int n_cell;
+    int max_grid_size;
+
+    pp.get("n_cell",n_cell);
+    pp.get("max_grid_size",max_grid_size);
+
+    build_grids(geom, grids, n_cell, max_grid_size);
+  }
 
   PArray<MultiFab> soln(nlevel, PArrayManage);
   PArray<MultiFab> soln1(nlevel, PArrayNoManage);
@@ -176,7 +208,7 @@ int main(int argc, char* argv[])
       soln1[ilev].setVal(0.0);
     }    
 
-    //    solve_with_Cpp(soln1, a, b, alph, beta, rhs, geom, grids, nlevel, ibnd);
+    solve_with_Cpp(soln1, a, b, alph, beta, rhs, geom, grids, ibnd);
 
     if (nsoln > 1) { // soln1 doesn't point to the same multifabs as soln
       for (int ilev=0; ilev < nlevel; ilev++) {
@@ -237,17 +269,9 @@ int main(int argc, char* argv[])
   BoxLib::Finalize();
 }
 
-void build_grids(std::vector<Geometry>& geom, std::vector<BoxArray>& grids)
+void build_grids(std::vector<Geometry>& geom, std::vector<BoxArray>& grids,
+		 int n_cell, int max_grid_size)
 {
-  ParmParse pp;
-  
-  // build the gridse level
-  int n_cell;
-  int max_grid_size;
-
-  pp.get("n_cell",n_cell);
-  pp.get("max_grid_size",max_grid_size);
-
   // Define a single box covering the domain
 #if (BL_SPACEDIM == 1)
   IntVect dom0_lo(0);
@@ -0,0 +1,21 @@
+#!/bin/sh
+#
+# Runs the solver benchmark for several numbers of MPI ranks and OpenMP
+# threads, appending to the same CSV file.  E.g.
+#
+#   ./run_bench.sh ./LST3d.gnu.MPI.OMP.ex "1 2 4 8" "1 2 4"
+#
+# Additional arguments are passed on to the executable as inputs.
+#
+EXE=${1:?"usage: run_bench.sh executable [ranks] [threads] [inputs...]"}
+RANKS=${2:-"1 2 4"}
+THREADS=${3:-"1"}
+if [ $# -ge 3 ]; then shift 3; else shift $#; fi
+MPIRUN=${MPIRUN:-mpiexec}
+
+for np in $RANKS; do
+    for nt in $THREADS; do
+        echo "==== $np ranks, $nt threads"
+        OMP_NUM_THREADS=$nt $MPIRUN -n $np $EXE inputs.bench "$@" || exit 1
+    done
+done
@@ -0,0 +1,88 @@
+#include <Utility.H>
+#include <ParmParse.H>
+#include <PArray.H>
+#include <LO_BCTYPES.H>
+#include <MultiFab.H>
+#include <Geometry.H>
+#include <BndryData.H>
+#include <MultiFabUtil.H>
+
+#include <ABecLaplacian.H>
+#include <MultiGrid.H>
+
+void solve_with_Cpp(PArray<MultiFab>& soln, Real a, Real b,
+		    const PArray<MultiFab>& alph,
+		    const PArray<MultiFab>& beta,
+		    PArray<MultiFab>& rhs,
+		    const std::vector<Geometry>& geom,
+		    const std::vector<BoxArray>& grids,
+		    int ibnd)
+{
+  const Real run_strt = ParallelDescriptor::second();
+
+  Real tolerance_rel, tolerance_abs;
+  {
+    ParmParse pp;
+    pp.get("tol_rel", tolerance_rel);
+    pp.get("tol_abs", tolerance_abs);
+  }
+
+  int nlevel = geom.size();
+
+  if (nlevel > 1) {
+    BoxLib::Error("BoxLib_C solver only supports max_level = 0");
+  }
+
+  const int ilev = 0;
+  const Geometry& geo = geom[ilev];
+  const Box& domain = geo.Domain();
+
+  BndryData bd(grids[ilev], 1, geo);
+
+  int comp = 0;
+  Real bc_value = 0.0; // This is hardwired.
+
+  for (OrientationIter fi; fi; ++fi) {
+    Orientation face(fi());
+    int dir = face.coordDir();
+
+    for (FabSetIter bfsi(bd[face]); bfsi.isValid(); ++bfsi) {
+      const int i = bfsi.index();
+      const Box& grd = grids[ilev][i];
+
+      bd.setBoundLoc(face, i, 0.0);
+      if (domain[face] == grd[face] && !geo.isPeriodic(dir)) {
+	bd.setBoundCond(face, i, comp, ibnd);
+	bd.setValue(face, i, bc_value);
+      }
+      else {
+	// internal or periodic bndry, never used
+	bd.setBoundCond(face, i, comp, LO_DIRICHLET);
+      }
+    }
+  }
+
+  PArray<MultiFab> bcoeffs(BL_SPACEDIM, PArrayManage);
+  for (int n = 0; n < BL_SPACEDIM ; n++)
+  {
+    BoxArray edge_boxes(grids[ilev]);
+    edge_boxes.surroundingNodes(n);
+    bcoeffs.set(n, new MultiFab(edge_boxes, 1, 0));
+  }
+
+  BoxLib::average_cellcenter_to_face(bcoeffs, beta[ilev], geo);
+
+  ABecLaplacian abec(bd, geo.CellSize());
+  abec.setScalars(a, b);
+  abec.setCoefficients(alph[ilev], bcoeffs);
+
+  MultiGrid mg(abec);
+  mg.solve(soln[ilev], rhs[ilev], tolerance_rel, tolerance_abs);
+
+  Real run_time = ParallelDescriptor::second() - run_strt;
+
+  ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+  if (ParallelDescriptor::IOProcessor()) {
+    std::cout << "Total BoxLib_C Run time      : " << run_time << std::endl;
+  }
+}
@@ -1,5 +1,6 @@
 
-subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostics, stencil_order, fabio)
+subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostics, stencil_order, fabio, &
+                             compare_bottom_solver)
 
   use BoxLib
   use cc_stencil_module
@@ -36,6 +37,7 @@ subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostic
   integer        , intent(in   ) :: do_diagnostics 
   integer        , intent(in   ) :: stencil_order
   logical        , intent(in   ) :: fabio
+  integer        , intent(in   ) :: compare_bottom_solver
 
   type(box      )                :: pd
 
@@ -43,6 +45,7 @@ subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostic
   type(multifab), allocatable :: edge_coeffs(:,:)
 
   type( multifab), allocatable   :: full_soln(:)
+  type( multifab), allocatable   :: cmp_soln(:), cmp_rh(:)
 
   type(multifab)                 :: cell_coeffs
 
@@ -50,7 +53,7 @@ subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostic
   real(dp_t)     , allocatable   :: xa(:), xb(:), pxa(:), pxb(:)
 
   integer        , allocatable   :: ref_ratio(:,:)
-  integer                        :: d, n, dm, nlevs
+  integer                        :: d, n, dm, nlevs, bottom_solver
 
   real(dp_t)                     :: snrm(2)
 
@@ -144,6 +147,17 @@ subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostic
 !    print *, 'RHS MAX NORM ', snrm(2)
 ! end if
 
+  ! ml_cc may change rh, so keep a copy for the comparison solve.
+  if ( compare_bottom_solver >= 0 ) then
+     allocate(cmp_soln(nlevs), cmp_rh(nlevs))
+     do n = nlevs, 1, -1
+        call multifab_build(cmp_soln(n), mla%la(n), 1, 1)
+        call setval(cmp_soln(n), val = ZERO, all=.true.)
+        call multifab_build(cmp_rh(n), mla%la(n), 1, nghost(rh(n)))
+        call copy(cmp_rh(n), rh(n))
+     end do
+  end if
+
 ! ****************************************************************************
 
   call ml_cc(mla, mgt, rh, full_soln, mla%mask, do_diagnostics)
@@ -154,6 +168,40 @@ subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostic
      call fabio_ml_write(full_soln, ref_ratio(:,1), "soln_cc")
   end if
 
+  ! Solve the same problem again with another bottom solver and check that
+  ! the two solutions agree to well within the solver tolerance.
+  if ( compare_bottom_solver >= 0 ) then
+
+     bottom_solver = mgt(1)%bottom_solver
+     mgt(1)%bottom_solver = compare_bottom_solver
+
+     call ml_cc(mla, mgt, cmp_rh, cmp_soln, mla%mask, do_diagnostics)
+
+     mgt(1)%bottom_solver = bottom_solver
+
+     do n = 1,nlevs
+        call saxpy(cmp_soln(n), -ONE, full_soln(n))
+     end do
+
+     snrm(1) = ml_norm_inf(cmp_soln,mla%mask)
+     snrm(2) = ml_norm_inf(full_soln,mla%mask)
+
+     if ( parallel_IOProcessor() ) then
+        print *, 'BOTTOM SOLVER ', bottom_solver, ' VS ', compare_bottom_solver, &
+                 ': MAX SOLUTION DIFFERENCE ', snrm(1), ' SOLUTION MAX NORM ', snrm(2)
+     end if
+
+     if ( snrm(1) > 1.e-6_dp_t * snrm(2) ) &
+          call bl_error("T_CC_ML_MULTIGRID: solutions with the two bottom solvers differ")
+
+     do n = 1,nlevs
+        call multifab_destroy(cmp_soln(n))
+        call multifab_destroy(cmp_rh(n))
+     end do
+     deallocate(cmp_soln, cmp_rh)
+
+  end if
+
 ! snrm(1) = ml_norm_l2(full_soln,ref_ratio,mla%mask)
 ! snrm(2) = ml_norm_inf(full_soln,mla%mask)
 ! if ( parallel_IOProcessor() ) then
@@ -16,7 +16,7 @@ subroutine wrapper()
 
   interface
      subroutine t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, &
-                                  do_diagnostics, stencil_order, fabio)
+                                  do_diagnostics, stencil_order, fabio, compare_bottom_solver)
        use mg_module    
        use ml_boxarray_module    
        use ml_layout_module    
@@ -28,6 +28,7 @@ subroutine wrapper()
        integer        , intent(in   ) :: do_diagnostics
        integer        , intent(in   ) :: stencil_order
        logical        , intent(in   ) :: fabio
+       integer        , intent(in   ) :: compare_bottom_solver
      end subroutine t_cc_ml_multigrid
 
      subroutine t_nodal_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, &
@@ -81,6 +82,7 @@ subroutine wrapper()
   ! MG solver defaults
   integer :: bottom_solver, bottom_max_iter
   integer :: bottom_solver_in, bottom_max_iter_in
+  integer :: compare_bottom_solver
   real(dp_t) :: bottom_solver_eps
   real(dp_t) :: eps
   integer :: max_iter
@@ -142,6 +144,7 @@ subroutine wrapper()
   namelist /probin/ eps, max_iter
   namelist /probin/ nu1, nu2, nub, nuf
   namelist /probin/ bottom_solver, bottom_solver_eps, bottom_max_iter
+  namelist /probin/ compare_bottom_solver
   namelist /probin/ solver, smoother
   namelist /probin/ min_width, max_nlevel
   namelist /probin/ stencil_order
@@ -206,6 +209,7 @@ subroutine wrapper()
   bottom_solver     = mgt_default%bottom_solver
   bottom_max_iter   = mgt_default%bottom_max_iter
   bottom_solver_eps = mgt_default%bottom_solver_eps
+  compare_bottom_solver = -1
   max_iter          = mgt_default%max_iter
   max_nlevel        = mgt_default%max_nlevel
   min_width         = mgt_default%min_width
@@ -360,6 +364,10 @@ subroutine wrapper()
            farg = farg + 1
            call get_command_argument(farg, value = fname)
            read(fname, *) bottom_max_iter
+        case ('--compare_bottom_solver')
+           farg = farg + 1
+           call get_command_argument(farg, value = fname)
+           read(fname, *) compare_bottom_solver
 
         case ('--maxsize')
            farg = farg + 1
@@ -710,7 +718,8 @@ subroutine wrapper()
   if ( nodal_in ) then
      call t_nodal_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostics, test, fabio, stencil_type)
   else
-     call t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostics, stencil_order, fabio)
+     call t_cc_ml_multigrid(mla, mgt, rh, coeffs_type, domain_bc, do_diagnostics, stencil_order, fabio, &
+                            compare_bottom_solver)
   end if
   call wall_second(wce)
   wce = wce - wcb
@@ -0,0 +1,322 @@
+//
+// Benchmark for the hot paths of ParticleContainer.  See README.
+//
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+#include <BoxLib.H>
+#include <MultiFab.H>
+#include <ParmParse.H>
+#include <Utility.H>
+
+#include <Particles.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    const int NOps = 5;
+
+    const char* OpNames[NOps] = { "InitRandom", "Redistribute", "AssignDensity", "moveKick", "Checkpoint" };
+
+    struct Params
+    {
+        int         n_cell;
+        int         max_grid_size;
+        int         nreps;
+        bool        weak;
+        bool        do_checkpoint;
+        std::string checkpoint_dir;
+        std::string outfile;
+        unsigned long seed;
+    };
+    //
+    // Minimum over the repetitions of the max over the MPI ranks.
+    //
+    Real
+    MinMaxTime (Array<Real>& times)
+    {
+        ParallelDescriptor::ReduceRealMax(times.dataPtr(), times.size());
+        return *std::min_element(times.begin(), times.end());
+    }
+    //
+    // Times all operations for one particle layout, particle count and thread count.
+    // Returns the minimum time of each operation; negative means not timed.
+    //
+    template <int NR, int NI>
+    Array<Real>
+    RunOne (const Params& prm, const Geometry& geom, const BoxArray& ba,
+            const DistributionMapping& dm, long npart)
+    {
+        typedef ParticleContainer<NR,NI> PC;
+
+        Array<Real> result(NOps, -1);
+        Array<Real> times(prm.nreps);
+
+        PC pc(geom, dm, ba);
+
+        pc.SetVerbose(0);
+
+        const Real mass = 1.0;
+
+        for (int r = 0; r < prm.nreps; r++)
+        {
+            pc.RemoveParticlesAtLevel(0);
+            ParallelDescriptor::Barrier();
+            const Real strt = ParallelDescriptor::second();
+            pc.InitRandom(npart, prm.seed, mass);
+            times[r] = ParallelDescriptor::second() - strt;
+        }
+        result[0] = MinMaxTime(times);
+        //
+        // Redistribute after displacing every particle by up to half a cell.
+        // The displacement itself is not timed.
+        //
+        const Real* dx = geom.CellSize();
+
+        BoxLib::mt19937 rn(prm.seed + ParallelDescriptor::MyProc());
+
+        for (int r = 0; r < prm.nreps; r++)
+        {
+            for (auto& kv : pc.GetParticles(0))
+            {
+                for (auto& p : kv.second)
+                {
+                    for (int d = 0; d < BL_SPACEDIM; d++)
+                        p.m_pos[d] += 0.5*dx[d]*(2*rn.d_value()-1);
+
+                    ParticleBase::Reset(p, pc.GetParGDB(), true);
+                }
+            }
+            ParallelDescriptor::Barrier();
+            const Real strt = ParallelDescriptor::second();
+            pc.Redistribute(true);
+            times[r] = ParallelDescriptor::second() - strt;
+        }
+        result[1] = MinMaxTime(times);
+
+        MultiFab rho(ba, 1, 1, dm);
+
+        for (int r = 0; r < prm.nreps; r++)
+        {
+            rho.setVal(0.0);
+            ParallelDescriptor::Barrier();
+            const Real strt = ParallelDescriptor::second();
+            pc.AssignDensitySingleLevel(0, rho, 0);
+            times[r] = ParallelDescriptor::second() - strt;
+        }
+        result[2] = MinMaxTime(times);
+
+        MultiFab accel(ba, BL_SPACEDIM, 1, dm);
+
+        accel.setVal(1.0);
+
+        for (int r = 0; r < prm.nreps; r++)
+        {
+            ParallelDescriptor::Barrier();
+            const Real strt = ParallelDescriptor::second();
+            pc.moveKick(accel, 0, 1.e-3);
+            times[r] = ParallelDescriptor::second() - strt;
+        }
+        result[3] = MinMaxTime(times);
+
+        if (prm.do_checkpoint)
+        {
+            for (int r = 0; r < prm.nreps; r++)
+            {
+                ParallelDescriptor::Barrier();
+                const Real strt = ParallelDescriptor::second();
+                pc.Checkpoint(prm.checkpoint_dir, "Particles");
+                times[r] = ParallelDescriptor::second() - strt;
+            }
+            result[4] = MinMaxTime(times);
+        }
+
+        return result;
+    }
+
+    Array<Real>
+    RunLayout (const std::string& layout, const Params& prm, const Geometry& geom,
+               const BoxArray& ba, const DistributionMapping& dm, long npart)
+    {
+        if (layout == "4_0")  return RunOne< 4,0>(prm, geom, ba, dm, npart);
+        if (layout == "7_0")  return RunOne< 7,0>(prm, geom, ba, dm, npart);
+        if (layout == "7_2")  return RunOne< 7,2>(prm, geom, ba, dm, npart);
+        if (layout == "16_0") return RunOne<16,0>(prm, geom, ba, dm, npart);
+
+        BoxLib::Abort(("ParticleBenchmark: unsupported layout " + layout).c_str());
+
+        return Array<Real>();
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    BoxLib::Initialize(argc,argv);
+
+    BL_PROFILE_VAR("main()", pmain);
+
+    Params prm;
+
+    Array<int>         nppc;
+    Array<int>         nthreads;
+    Array<std::string> layouts;
+    {
+        ParmParse pp;
+
+        prm.n_cell = 64;
+        pp.query("n_cell", prm.n_cell);
+        prm.max_grid_size = 32;
+        pp.query("max_grid_size", prm.max_grid_size);
+        prm.nreps = 3;
+        pp.query("nreps", prm.nreps);
+        std::string scaling("strong");
+        pp.query("scaling", scaling);
+        prm.weak = (scaling == "weak");
+        int do_checkpoint = 1;
+        pp.query("do_checkpoint", do_checkpoint);
+        prm.do_checkpoint = do_checkpoint;
+        prm.checkpoint_dir = "pbench_chk";
+        pp.query("checkpoint_dir", prm.checkpoint_dir);
+        prm.outfile = "pbench.dat";
+        pp.query("outfile", prm.outfile);
+        int seed = 451;
+        pp.query("seed", seed);
+        prm.seed = seed;
+
+        if (pp.countval("nppc") > 0)
+            pp.getarr("nppc", nppc, 0, pp.countval("nppc"));
+        else
+            nppc.push_back(1);
+
+        if (pp.countval("layouts") > 0)
+            pp.getarr("layouts", layouts, 0, pp.countval("layouts"));
+        else
+            layouts.push_back("7_0");
+
+        if (pp.countval("nthreads") > 0)
+            pp.getarr("nthreads", nthreads, 0, pp.countval("nthreads"));
+        else
+            nthreads.push_back(1);
+    }
+
+#ifndef _OPENMP
+    nthreads.resize(1);
+    nthreads[0] = 1;
+#endif
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n,0.0);
+        real_box.setHi(n,1.0);
+    }
+    const Box domain(IntVect::TheZeroVector(), IntVect(D_DECL(prm.n_cell-1,prm.n_cell-1,prm.n_cell-1)));
+
+    int is_per[BL_SPACEDIM];
+    for (int i = 0; i < BL_SPACEDIM; i++) is_per[i] = 1;
+
+    Geometry geom(domain, &real_box, 0, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(prm.max_grid_size);
+
+    DistributionMapping dm(ba, ParallelDescriptor::NProcs());
+
+    const int NProcs = ParallelDescriptor::NProcs();
+
+    std::ofstream ofs;
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        ofs.open(prm.outfile.c_str(), std::ios::out|std::ios::app);
+        if (!ofs.good())
+            BoxLib::FileOpenFailed(prm.outfile);
+
+        std::cout << "ParticleBenchmark: " << NProcs << " procs, "
+                  << ba.size() << " grids, domain " << domain
+                  << (prm.weak ? ", weak" : ", strong") << " scaling\n";
+    }
+
+    for (int il = 0; il < layouts.size(); il++)
+    {
+        for (int ip = 0; ip < nppc.size(); ip++)
+        {
+            long npart = long(nppc[ip]) * domain.numPts();
+
+            if (prm.weak) npart *= NProcs;
+            //
+            // times[thread count][operation]
+            //
+            Array< Array<Real> > times(nthreads.size());
+
+            for (int it = 0; it < nthreads.size(); it++)
+            {
+#ifdef _OPENMP
+                omp_set_num_threads(nthreads[it]);
+#endif
+                times[it] = RunLayout(layouts[il], prm, geom, ba, dm, npart);
+
+                if (ParallelDescriptor::IOProcessor())
+                {
+                    for (int op = 0; op < NOps; op++)
+                    {
+                        if (times[it][op] < 0) continue;
+
+                        ofs << NProcs            << ' '
+                            << nthreads[it]      << ' '
+                            << layouts[il]       << ' '
+                            << npart             << ' '
+                            << OpNames[op]       << ' '
+                            << times[it][op]     << ' '
+                            << npart/times[it][op] << '\n';
+                    }
+                }
+            }
+
+            if (ParallelDescriptor::IOProcessor())
+            {
+                const int oldprec = std::cout.precision(4);
+
+                std::cout << "\nlayout NR_NI = " << layouts[il]
+                          << ", particles = " << npart << '\n';
+                std::cout << std::setw(14) << "operation"
+                          << std::setw(9)  << "threads"
+                          << std::setw(14) << "seconds"
+                          << std::setw(14) << "particles/s"
+                          << std::setw(10) << "speedup"
+                          << std::setw(12) << "efficiency" << '\n';
+
+                for (int op = 0; op < NOps; op++)
+                {
+                    for (int it = 0; it < nthreads.size(); it++)
+                    {
+                        if (times[it][op] < 0) continue;
+
+                        const Real speedup = times[0][op] / times[it][op];
+                        const Real eff     = speedup * nthreads[0] / nthreads[it];
+
+                        std::cout << std::setw(14) << OpNames[op]
+                                  << std::setw(9)  << nthreads[it]
+                                  << std::setw(14) << times[it][op]
+                                  << std::setw(14) << npart/times[it][op]
+                                  << std::setw(10) << speedup
+                                  << std::setw(12) << eff << '\n';
+                    }
+                }
+
+                std::cout.precision(oldprec);
+            }
+        }
+    }
+
+    BL_PROFILE_VAR_STOP(pmain);
+
+    BoxLib::Finalize();
+}
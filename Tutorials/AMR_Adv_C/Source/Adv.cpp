@@ -8,6 +8,7 @@
 int      Adv::verbose         = 0;
 Real     Adv::cfl             = 0.9;
 int      Adv::do_reflux       = 1;
+int      Adv::check_derive    = 0;
 
 int      Adv::NUM_STATE       = 1;  // One variable in the state
 int      Adv::NUM_GROW        = 3;  // number of ghost cells
@@ -26,6 +27,7 @@ Adv::read_params ()
     pp.query("v",verbose);
     pp.query("cfl",cfl);
     pp.query("do_reflux",do_reflux);
+    pp.query("check_derive",check_derive);
 
     // This tutorial code only supports Cartesian coordinates.
     if (! Geometry::IsCartesian()) {
@@ -100,6 +100,21 @@ Adv::computeNewDt (int                   finest_level,
 	    dt_min[i] = std::min(dt_min[i],change_max*dt_level[i]);
 	}
     }
+
+    //
+    // With amr.subcycling_mode = Optimal choose the number of subcycles
+    // on each level that minimizes the estimated work per unit time.
+    //
+    if (parent->subcyclingMode() == "Optimal" && finest_level > 0)
+    {
+        Array<int> cycle_max(finest_level+1);
+        cycle_max[0] = 1;
+        for (int i = 1; i <= finest_level; i++)
+            cycle_max[i] = parent->MaxRefRatio(i-1);
+
+        parent->computeOptimalSubcycling(finest_level+1, n_cycle.dataPtr(),
+                                         dt_min.dataPtr(), cycle_max.dataPtr());
+    }
     
     //
     // Find the minimum over all levels
@@ -38,7 +38,19 @@ Adv::writePlotFile (const std::string& dir,
                 desc_lst[typ].getType() == IndexType::TheCellType())
                 plot_var_map.push_back(std::pair<int,int>(typ,comp));
 
-    int n_data_items = plot_var_map.size();
+    std::vector<std::string> derive_names;
+    int num_derive = 0;
+    const std::list<DeriveRec>& dlist = derive_lst.dlist();
+    for (std::list<DeriveRec>::const_iterator it = dlist.begin(); it != dlist.end(); ++it)
+    {
+        if (parent->isDerivePlotVar(it->name()))
+        {
+            derive_names.push_back(it->name());
+            num_derive += it->numDerive();
+        }
+    }
+
+    int n_data_items = plot_var_map.size() + num_derive;
 
     Real cur_time = state[State_Type].curTime();
 
@@ -64,6 +76,13 @@ Adv::writePlotFile (const std::string& dir,
 	    os << desc_lst[typ].name(comp) << '\n';
         }
 
+	for (i = 0; i < derive_names.size(); i++)
+	{
+	    const DeriveRec* rec = derive_lst.get(derive_names[i]);
+	    for (n = 0; n < rec->numDerive(); n++)
+		os << rec->variableName(n) << '\n';
+	}
+
         os << BL_SPACEDIM << '\n';
         os << parent->cumTime() << '\n';
         int f_lev = parent->finestLevel();
@@ -144,7 +163,7 @@ Adv::writePlotFile (const std::string& dir,
     //
     // We combine all of the multifabs -- state, derived, etc -- into one
     // multifab -- plotMF.
-    // NOTE: In this tutorial code, there is no derived data
+    //
     int       cnt   = 0;
     const int nGrow = 0;
     MultiFab  plotMF(grids,n_data_items,nGrow);
@@ -160,6 +179,41 @@ Adv::writePlotFile (const std::string& dir,
 	MultiFab::Copy(plotMF,*this_dat,comp,cnt,1,nGrow);
 	cnt++;
     }
+    //
+    // Compute all the derived quantities at once.
+    //
+    if (!derive_names.empty())
+    {
+	deriveBatch(derive_names,cur_time,plotMF,cnt);
+
+	if (check_derive)
+	{
+	    for (i = 0; i < derive_names.size(); i++)
+	    {
+		MultiFab* one = derive(derive_names[i],cur_time,nGrow);
+
+		MultiFab::Subtract(*one,plotMF,cnt,0,one->nComp(),nGrow);
+
+		for (n = 0; n < one->nComp(); n++)
+		{
+		    if (one->norm0(n) != 0)
+		    {
+			std::string msg("Adv::writePlotFile: deriveBatch and derive differ for ");
+			msg += derive_names[i];
+			BoxLib::Abort(msg.c_str());
+		    }
+		}
+
+		cnt += one->nComp();
+
+		delete one;
+	    }
+	}
+	else
+	{
+	    cnt += num_derive;
+	}
+    }
 
     //
     // Use the Full pathname when naming the MultiFab.
@@ -8,6 +8,7 @@ void
 Adv::variableCleanUp () 
 {
     desc_lst.clear();
+    derive_lst.clear();
 }
 
 void
@@ -33,6 +34,13 @@ Adv::variableSetUp ()
     desc_lst.setComponent(State_Type, 0, "phi", bc, 
 			  StateDescriptor::BndryFunc(nullfill));
 
+    //
+    // |grad phi|; plotted only if listed in amr.derive_plot_vars.
+    //
+    derive_lst.add("gradphi",IndexType::TheCellType(),1,
+                   derivegradphi,DeriveRec::GrowBoxByOne);
+    derive_lst.addComponent("gradphi",desc_lst,State_Type,0,1);
+
     //
     // read taggin parameters from probin file
     //
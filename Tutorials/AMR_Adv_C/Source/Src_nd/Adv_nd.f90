@@ -61,3 +61,37 @@ subroutine get_tagging_params(name, namlen) bind(C, name="get_tagging_params")
   
 end subroutine get_tagging_params
 
+
+subroutine derivegradphi(gp,gp_lo,gp_hi,ngp,phi,phi_lo,phi_hi,nphi, &
+                         lo,hi,domlo,domhi,delta,xlo,time,dt,bc,level,grid_no) &
+                         bind(C, name="derivegradphi")
+  implicit none
+  integer          :: gp_lo(3),gp_hi(3),ngp
+  integer          :: phi_lo(3),phi_hi(3),nphi
+  integer          :: lo(3),hi(3),domlo(3),domhi(3)
+  integer          :: bc(*),level,grid_no
+  double precision :: delta(3),xlo(3),time,dt
+  double precision :: gp (gp_lo(1):gp_hi(1),gp_lo(2):gp_hi(2),gp_lo(3):gp_hi(3),ngp)
+  double precision :: phi(phi_lo(1):phi_hi(1),phi_lo(2):phi_hi(2),phi_lo(3):phi_hi(3),nphi)
+
+  integer          :: i, j, k
+  double precision :: gx, gy, gz
+
+  ! |grad phi| with centered differences; z only when the source has z
+  ! ghost cells, i.e. in 3D
+  gz = 0.d0
+
+  do k = lo(3), hi(3)
+     do j = lo(2), hi(2)
+        do i = lo(1), hi(1)
+           gx = (phi(i+1,j,k,1) - phi(i-1,j,k,1)) / (2.d0*delta(1))
+           gy = (phi(i,j+1,k,1) - phi(i,j-1,k,1)) / (2.d0*delta(2))
+           if (phi_lo(3) .lt. lo(3)) then
+              gz = (phi(i,j,k+1,1) - phi(i,j,k-1,1)) / (2.d0*delta(3))
+           end if
+           gp(i,j,k,1) = sqrt(gx**2 + gy**2 + gz**2)
+        end do
+     end do
+  end do
+
+end subroutine derivegradphi